@@ -0,0 +1,107 @@
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include "PriorityQueueMinHeap.h"
+#include "PriorityExecutor.h"
+
+#ifndef SD_P2_ASYNCPRIORITYQUEUE_H
+#define SD_P2_ASYNCPRIORITYQUEUE_H
+
+//Priority queue for coroutines: co_await queue.dequeue() suspends until an element is there
+//An enqueue that finds coroutines waiting hands its element straight to the one that waits longest and queues it
+//on the executor with the priority of the element, so urgent elements also get their consumers resumed first
+//Elements nobody waits for go into the backend, any single-threaded backend of this repo
+template <typename T, typename Backend = PriorityQueueMinHeap<T>, typename Executor = PriorityExecutor<>>
+class AsyncPriorityQueue {
+public:
+    class DequeueAwaiter {
+    public:
+        explicit DequeueAwaiter(AsyncPriorityQueue& queue) : queue(queue) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        //Takes an element at once if there is one, otherwise waits in line without holding a thread
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> guard(queue.mutex);
+            if (!queue.backend.isEmpty()) {
+                element = queue.backend.dequeue();
+                return false;
+            }
+            this->handle = handle;
+            queue.waiters.push_back(this);
+            return true;
+        }
+
+        T await_resume() {
+            return std::move(element);
+        }
+
+    private:
+        friend class AsyncPriorityQueue;
+
+        AsyncPriorityQueue& queue;
+        std::coroutine_handle<> handle;
+        T element{};
+    };
+
+    explicit AsyncPriorityQueue(Executor& executor) : executor(executor) {}
+
+    AsyncPriorityQueue(const AsyncPriorityQueue&) = delete;
+    AsyncPriorityQueue& operator=(const AsyncPriorityQueue&) = delete;
+
+    //Safe from any thread and from coroutines, never suspends
+    void enqueue(T element, int priority) {
+        DequeueAwaiter* waiter = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (waiters.empty()) {
+                backend.enqueue(std::move(element), priority);
+                return;
+            }
+            waiter = waiters.front();
+            waiters.pop_front();
+            waiter->element = std::move(element);
+        }
+        executor.post(waiter->handle, priority);
+    }
+
+    //Awaitable giving the most urgent element
+    DequeueAwaiter dequeue() {
+        return DequeueAwaiter(*this);
+    }
+
+    //Removes the most urgent element into element without waiting, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (backend.isEmpty()) return false;
+        element = backend.dequeue();
+        return true;
+    }
+
+    int getSize() {
+        std::lock_guard<std::mutex> guard(mutex);
+        return backend.getSize();
+    }
+
+    bool isEmpty() {
+        std::lock_guard<std::mutex> guard(mutex);
+        return backend.isEmpty();
+    }
+
+    //Number of coroutines suspended in dequeue
+    int waitingConsumers() {
+        std::lock_guard<std::mutex> guard(mutex);
+        return static_cast<int>(waiters.size());
+    }
+
+private:
+    Executor& executor;
+    std::mutex mutex;
+    Backend backend;
+    std::deque<DequeueAwaiter*> waiters;
+};
+
+#endif //SD_P2_ASYNCPRIORITYQUEUE_H
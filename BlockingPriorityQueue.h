@@ -0,0 +1,178 @@
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "ConcurrentSync.h"
+#include "ConcurrentPriorityQueue.h"
+#include "EventCount.h"
+
+#ifndef SD_P2_BLOCKINGPRIORITYQUEUE_H
+#define SD_P2_BLOCKINGPRIORITYQUEUE_H
+
+//Lets consumers sleep on an empty queue instead of polling isEmpty
+//The backend is shared through ConcurrentPriorityQueue and the sleeping consumers wait on an EventCount,
+//so an enqueue costs one fence and one load on top of the locked call while nobody waits
+//An enqueue wakes one consumer and a bulk enqueue or a meld one per added element, never more than are asleep
+//close wakes every consumer; the waiting calls then hand out what is left and give up once the queue is empty
+template <typename Backend, typename Sync = MutexSync>
+class BlockingPriorityQueue : public PriorityQueue<typename Backend::value_type> {
+public:
+    using T = typename Backend::value_type;
+
+private:
+    ConcurrentPriorityQueue<Backend, Sync> queue;
+    mutable EventCount nonEmpty;
+    std::atomic<bool> closed{false};
+
+public:
+    BlockingPriorityQueue() = default;
+
+    //Constructs the backend from the arguments
+    template <typename... Args>
+    explicit BlockingPriorityQueue(std::in_place_t, Args&&... args) : queue(std::in_place, std::forward<Args>(args)...) {}
+
+    BlockingPriorityQueue(const BlockingPriorityQueue&) = delete;
+    BlockingPriorityQueue& operator=(const BlockingPriorityQueue&) = delete;
+
+    void enqueue(T element, int priority) override {
+        queue.enqueue(std::move(element), priority);
+        nonEmpty.notify(1);
+    }
+
+    //Does not wait, throws like every other backend when the queue is empty
+    T dequeue() override {
+        return queue.dequeue();
+    }
+
+    //Removes the most urgent element into element, returns false at once if the queue is empty
+    bool tryDequeue(T& element) {
+        return queue.tryDequeue(element);
+    }
+
+    //Removes the most urgent element into element, sleeping while the queue is empty
+    //Returns false once the queue is closed and empty
+    bool waitDequeue(T& element) {
+        while (!queue.tryDequeue(element)) {
+            uint32_t key = nonEmpty.prepareWait();
+            if (queue.tryDequeue(element)) {
+                nonEmpty.cancelWait();
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                nonEmpty.cancelWait();
+                return false;
+            }
+            nonEmpty.wait(key);
+        }
+        return true;
+    }
+
+    //Removes the most urgent element, sleeping while the queue is empty
+    //Throws once the queue is closed and empty
+    T waitDequeue() {
+        T element;
+        if (!waitDequeue(element)) throw std::runtime_error("Queue is closed");
+        return element;
+    }
+
+    //Removes the most urgent element into element, sleeping until deadline at most
+    //Returns false if the queue stayed empty until then or is closed and empty
+    template <typename Clock, typename Duration>
+    bool waitDequeueUntil(T& element, const std::chrono::time_point<Clock, Duration>& deadline) {
+        while (!queue.tryDequeue(element)) {
+            auto left = deadline - Clock::now();
+            if (left <= Duration::zero()) return false;
+            //The sleep runs on the steady clock, a deadline of another clock is turned into a steady one each round
+            EventCount::Clock::time_point steadyDeadline = EventCount::Clock::now()
+                + std::chrono::duration_cast<EventCount::Clock::duration>(left);
+            uint32_t key = nonEmpty.prepareWait();
+            if (queue.tryDequeue(element)) {
+                nonEmpty.cancelWait();
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                nonEmpty.cancelWait();
+                return false;
+            }
+            nonEmpty.waitUntil(key, steadyDeadline);
+        }
+        return true;
+    }
+
+    //Removes the most urgent element into element, sleeping for timeout at most
+    //Returns false if the queue stayed empty for that long or is closed and empty
+    template <typename Rep, typename Period>
+    bool waitDequeueFor(T& element, const std::chrono::duration<Rep, Period>& timeout) {
+        return waitDequeueUntil(element, EventCount::Clock::now() + std::chrono::duration_cast<EventCount::Clock::duration>(timeout));
+    }
+
+    //Wakes every waiting consumer, from now on the waiting calls give up instead of sleeping on an empty queue
+    //Elements may still be enqueued and are handed out as usual, so producers and consumers can finish in any order
+    void close() {
+        closed.store(true, std::memory_order_release);
+        nonEmpty.notify(INT_MAX);
+    }
+
+    bool isClosed() const {
+        return closed.load(std::memory_order_acquire);
+    }
+
+    //Number of consumers asleep or about to sleep
+    int waitingConsumers() const {
+        return nonEmpty.waiters();
+    }
+
+    T peek() const override {
+        return queue.peek();
+    }
+
+    int peekPriority() const override {
+        return queue.peekPriority();
+    }
+
+    int getSize() const override {
+        return queue.getSize();
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        queue.modifyPriority(std::move(element), newPriority);
+    }
+
+    bool isEmpty() const override {
+        return queue.isEmpty();
+    }
+
+    //A BlockingPriorityQueue of the same type hands its elements over in one locked step, see ConcurrentPriorityQueue
+    void meld(PriorityQueue<T>&& other) override {
+        if (&other == this) return;
+        std::vector<SnapshotEntry<T>> entries;
+        auto* blocking = dynamic_cast<BlockingPriorityQueue*>(&other);
+        ConcurrentPriorityQueue<Backend, Sync>::takeAll(blocking ? blocking->queue : other, entries);
+        int added = static_cast<int>(entries.size());
+        queue.enqueueBulk(entries);
+        nonEmpty.notify(added);
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        queue.forEachEntry(visit);
+    }
+
+    void saveSnapshot(const std::string& path) const override {
+        queue.saveSnapshot(path);
+    }
+
+protected:
+    //Snapshots are read outside the lock and arrive here as one batch
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        int added = static_cast<int>(entries.size());
+        queue.enqueueBulk(entries);
+        nonEmpty.notify(added);
+    }
+};
+
+#endif //SD_P2_BLOCKINGPRIORITYQUEUE_H
@@ -0,0 +1,149 @@
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "DynamicArray.h"
+
+#ifndef SD_P2_BOUNDEDPRIORITYQUEUE_H
+#define SD_P2_BOUNDEDPRIORITYQUEUE_H
+
+//Keeps the K elements with the lowest priorities seen in a stream
+//The kept elements form a max-heap, so the worst of them sits at the root and is the threshold
+//a new element has to beat; once the queue is full anything else is rejected in O(1)
+template <typename T, int K>
+class BoundedPriorityQueue {
+    static_assert(K > 0, "Capacity must be positive");
+
+private:
+    static constexpr int CHUNK = 64;
+
+    //Priorities are kept apart from the elements so the bulk filter only streams over integers
+    int priorities[K];
+    T elements[K];
+    int n;
+
+    void siftUp(int index) {
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (priorities[parent] >= priorities[index]) break;
+            std::swap(priorities[parent], priorities[index]);
+            std::swap(elements[parent], elements[index]);
+            index = parent;
+        }
+    }
+
+    void siftDown(int index, int size) {
+        while (true) {
+            int largest = index;
+            int left = 2 * index + 1;
+            int right = left + 1;
+            if (left < size && priorities[left] > priorities[largest]) largest = left;
+            if (right < size && priorities[right] > priorities[largest]) largest = right;
+            if (largest == index) break;
+            std::swap(priorities[largest], priorities[index]);
+            std::swap(elements[largest], elements[index]);
+            index = largest;
+        }
+    }
+
+    //Counts the priorities below the limit, written without branches so the compiler vectorizes it
+    static int countBelow(const int* values, int count, int limit) {
+        int hits = 0;
+        for (int i = 0; i < count; i++) {
+            hits += values[i] < limit;
+        }
+        return hits;
+    }
+
+public:
+    BoundedPriorityQueue() : n(0) {}
+
+    //Keeps the element if the queue is not full yet or if it beats the current threshold,
+    //evicting the worst kept element; returns whether the element was kept
+    bool offer(const T& element, int priority) {
+        if (n == K) {
+            if (priority >= priorities[0]) return false;
+            priorities[0] = priority;
+            elements[0] = element;
+            siftDown(0, n);
+            return true;
+        }
+        priorities[n] = priority;
+        elements[n] = element;
+        siftUp(n);
+        n++;
+        return true;
+    }
+
+    //Offers every pair of the two spans, returns the number of elements kept
+    //Once the queue is full whole chunks are compared against the threshold at once
+    //and only chunks holding a candidate are walked one by one
+    int offerBulk(std::span<const T> newElements, std::span<const int> newPriorities) {
+        if (newElements.size() != newPriorities.size()) {
+            throw std::invalid_argument("Elements and priorities differ in length");
+        }
+        int count = static_cast<int>(newElements.size());
+        int kept = 0;
+        int i = 0;
+        for (; i < count && n < K; i++) {
+            kept += offer(newElements[i], newPriorities[i]);
+        }
+        for (; i < count; i += CHUNK) {
+            int length = count - i < CHUNK ? count - i : CHUNK;
+            if (countBelow(newPriorities.data() + i, length, priorities[0]) == 0) continue;
+            for (int j = i; j < i + length; j++) {
+                kept += offer(newElements[j], newPriorities[j]);
+            }
+        }
+        return kept;
+    }
+
+    //Priority a new element has to beat once the queue is full
+    int threshold() const {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return priorities[0];
+    }
+
+    //Worst of the kept elements, the next one to be evicted
+    T peekWorst() const {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return elements[0];
+    }
+
+    //Appends the kept elements to out from the lowest priority to the highest and empties the queue
+    void drain(DynamicArray<T>& out) {
+        for (int size = n - 1; size > 0; size--) {
+            std::swap(priorities[0], priorities[size]);
+            std::swap(elements[0], elements[size]);
+            siftDown(0, size);
+        }
+        for (int i = 0; i < n; i++) {
+            out.pushBack(elements[i]);
+        }
+        clear();
+    }
+
+    void clear() {
+        for (int i = 0; i < n; i++) {
+            elements[i] = T();
+        }
+        n = 0;
+    }
+
+    int getSize() const {
+        return n;
+    }
+
+    int capacity() const {
+        return K;
+    }
+
+    bool isEmpty() const {
+        return n == 0;
+    }
+
+    bool isFull() const {
+        return n == K;
+    }
+};
+
+#endif //SD_P2_BOUNDEDPRIORITYQUEUE_H
@@ -0,0 +1,117 @@
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "ConcurrentSync.h"
+
+#ifndef SD_P2_CONCURRENTPRIORITYQUEUE_H
+#define SD_P2_CONCURRENTPRIORITYQUEUE_H
+
+//Makes any backend safe to share between threads
+//Every call runs as one operation of the Sync policy: SpinLockSync, MutexSync or FlatCombiningSync
+//Compound steps such as checking for emptiness and dequeuing are offered as single calls like tryDequeue,
+//since the answer of isEmpty may be stale by the time the caller acts on it
+template <typename Backend, typename Sync = MutexSync>
+class ConcurrentPriorityQueue : public PriorityQueue<typename Backend::value_type> {
+public:
+    using T = typename Backend::value_type;
+
+private:
+    Backend backend;
+    mutable Sync sync;
+
+public:
+    ConcurrentPriorityQueue() = default;
+
+    //Constructs the backend from the arguments
+    template <typename... Args>
+    explicit ConcurrentPriorityQueue(std::in_place_t, Args&&... args) : backend(std::forward<Args>(args)...) {}
+
+    ConcurrentPriorityQueue(const ConcurrentPriorityQueue&) = delete;
+    ConcurrentPriorityQueue& operator=(const ConcurrentPriorityQueue&) = delete;
+
+    void enqueue(T element, int priority) override {
+        sync.execute([&] { backend.enqueue(std::move(element), priority); });
+    }
+
+    T dequeue() override {
+        return sync.execute([&] { return backend.dequeue(); });
+    }
+
+    //Removes the most urgent element into element, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        return sync.execute([&] {
+            if (backend.isEmpty()) return false;
+            element = backend.dequeue();
+            return true;
+        });
+    }
+
+    T peek() const override {
+        return sync.execute([&] { return backend.peek(); });
+    }
+
+    int peekPriority() const override {
+        return sync.execute([&] { return backend.peekPriority(); });
+    }
+
+    int getSize() const override {
+        return sync.execute([&] { return backend.getSize(); });
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        sync.execute([&] { backend.modifyPriority(std::move(element), newPriority); });
+    }
+
+    bool isEmpty() const override {
+        return sync.execute([&] { return backend.isEmpty(); });
+    }
+
+    //Other is emptied before this queue is locked, so two queues melding into each other at once cannot deadlock
+    void meld(PriorityQueue<T>&& other) override {
+        if (&other == this) return;
+        std::vector<SnapshotEntry<T>> entries;
+        takeAll(other, entries);
+        loadEntries(entries);
+    }
+
+    //Moves every element of source into entries and leaves source empty
+    //A ConcurrentPriorityQueue of the same type hands its elements over in one locked step and may stay shared;
+    //any other queue is drained through its interface and must not be used by other threads meanwhile
+    static void takeAll(PriorityQueue<T>& source, std::vector<SnapshotEntry<T>>& entries) {
+        if (auto* shared = dynamic_cast<ConcurrentPriorityQueue*>(&source)) {
+            shared->sync.execute([&] { drain(shared->backend, entries); });
+        } else {
+            drain(source, entries);
+        }
+    }
+
+    //Visit runs while the queue is locked and must not call back into it
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        sync.execute([&] { backend.forEachEntry(visit); });
+    }
+
+    void saveSnapshot(const std::string& path) const override {
+        sync.execute([&] { backend.saveSnapshot(path); });
+    }
+
+    void loadSnapshot(const std::string& path) override {
+        sync.execute([&] { backend.loadSnapshot(path); });
+    }
+
+protected:
+    static void drain(PriorityQueue<T>& source, std::vector<SnapshotEntry<T>>& entries) {
+        while (!source.isEmpty()) {
+            int priority = source.peekPriority();
+            entries.push_back(SnapshotEntry<T>{priority, source.dequeue()});
+        }
+    }
+
+    //The whole batch goes in under one lock, through the bulk build of the backend
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        sync.execute([&] { backend.enqueueBulk(entries); });
+    }
+};
+
+#endif //SD_P2_CONCURRENTPRIORITYQUEUE_H
@@ -0,0 +1,417 @@
+#ifndef CONCURRENT_SYNC_H
+#define CONCURRENT_SYNC_H
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+//Synchronization policies for ConcurrentPriorityQueue
+//Every policy runs an operation with execute(operation) so that no other operation of the same policy object
+//runs at the same time, and returns its result or rethrows its exception in the calling thread
+
+constexpr int CACHE_LINE = 64; //Distance keeping data written by different threads on different cache lines
+
+//Small index of the calling thread, given back when the thread ends so that live threads keep the lowest indices
+class ThreadIndex {
+public:
+	static int current(); //Get the index of the calling thread
+	ThreadIndex(const ThreadIndex& other) = delete; //Indices belong to one thread
+	ThreadIndex& operator=(const ThreadIndex& other) = delete; //Indices belong to one thread
+private:
+	ThreadIndex(); //Constructor taking the lowest free index
+	~ThreadIndex(); //Destructor giving the index back
+	static std::mutex& registryMutex(); //Get the lock guarding the registry
+	static std::vector<bool>& registry(); //Get which indices are taken
+	int index_; //Index of the thread
+};
+
+//Xorshift generator of the calling thread, seeded from its ThreadIndex so that threads draw different sequences
+class ThreadRandom {
+public:
+	static uint32_t next(); //Get the next number of the calling thread
+};
+
+//Busy waiting that gives the core away after a while, so waiting threads do not starve the thread they wait for
+class SpinWait {
+public:
+	void wait(); //Wait a moment
+private:
+	static constexpr int SPINS_BEFORE_YIELD = 64; //Pauses before the thread starts yielding
+	int spins_ = 0; //Number of waits so far
+};
+
+//Lock on a single flag, waiting threads spin on a plain load and only retry the exchange once the flag is clear
+class SpinLockSync {
+public:
+	void lock(); //Acquire the lock
+	bool try_lock(); //Acquire the lock if it is free, returns whether it was acquired
+	void unlock(); //Release the lock
+	template <typename F>
+	std::invoke_result_t<F&> execute(F&& operation); //Run operation under the lock
+private:
+	alignas(CACHE_LINE) std::atomic<bool> locked_{false}; //Whether a thread holds the lock
+};
+
+//Heaps behind a spin lock each, with the priority at the head of every heap cached in an atomic
+//Threads compare the cached heads without taking a lock to choose a heap to take from or to steal from
+//Heap is a MinHeap of nodes or any backend of this repo; updateTop has to run under the lock after every change
+template <typename Heap>
+class LockedLanes {
+public:
+	static constexpr long long EMPTY = LLONG_MAX; //Cached head of an empty heap
+	struct alignas(CACHE_LINE) Lane {
+		SpinLockSync lock; //Guards heap
+		Heap heap; //Elements of the lane
+		std::atomic<long long> top{EMPTY}; //Priority at the head of heap, read without the lock
+		void updateTop(); //Refresh the cached head after heap changed
+	};
+	explicit LockedLanes(int count); //Constructor
+	LockedLanes(const LockedLanes& other) = delete; //Lanes are shared by address
+	LockedLanes& operator=(const LockedLanes& other) = delete; //Lanes are shared by address
+	Lane& operator[](int index) const; //Get lane at index
+	int count() const; //Get number of lanes
+	long long top(int index) const; //Get cached head of the lane at index
+	int best(int skip = -1) const; //Get the lane other than skip with the smallest cached head, or -1 if all looked empty
+	bool allEmpty() const; //Check every heap, the locked second look makes an empty answer certain
+	template <typename F>
+	bool untilLocked(F&& visit) const; //Run visit on the lanes one lock at a time until it returns true
+private:
+	std::unique_ptr<Lane[]> lanes_; //Lanes on their own cache lines
+	int count_; //Number of lanes
+};
+
+//Lock on std::mutex, waiting threads sleep in the system
+class MutexSync {
+public:
+	template <typename F>
+	std::invoke_result_t<F&> execute(F&& operation); //Run operation under the lock
+private:
+	std::mutex mutex_; //Lock guarding the operations
+};
+
+//Publication slots and combiner election of flat combining after Hendler, Incze, Shavit and Tzafrir
+//A thread publishes its request in a slot and the thread that gets the combiner flag serves the published
+//requests of all threads in passes, so the data stays in the cache of one core instead of moving with a lock
+//How a pass serves the requests is up to the user; Request needs an std::atomic<bool> done set through finish
+template <typename Request>
+class PublicationSlots {
+public:
+	template <typename Serve>
+	void publishAndWait(Request& request, Serve&& servePass); //Publish request and combine or wait until it is done
+	template <typename F>
+	std::invoke_result_t<F&> exclusive(F&& operation); //Run operation as the combiner, without serving requests
+	int used() const; //Get the number of slots a pass has to scan
+	Request* published(int slot) const; //Get the request waiting in slot, or nullptr
+	void finish(int slot, Request* request); //Free slot and let the owner of request go on
+private:
+	static constexpr int SLOTS = 128; //Publication slots, threads beyond this share slots
+	static constexpr int COMBINING_PASSES = 4; //Passes over the slots a combiner makes while it finds requests
+	struct alignas(CACHE_LINE) Slot {
+		std::atomic<Request*> request{nullptr}; //Published request waiting for a combiner
+	};
+	struct CombinerGuard {
+		std::atomic<bool>& flag; //Combiner flag released on destruction, also by an exception
+		~CombinerGuard() { flag.store(false, std::memory_order_release); }
+	};
+	static int threadSlot(); //Get the preferred slot of the calling thread
+	alignas(CACHE_LINE) std::atomic<bool> combining_{false}; //Whether a thread is combining
+	std::atomic<int> slotsInUse_{0}; //Slots before this index have been used, the combiner scans only them
+	Slot slots_[SLOTS]; //Publication slots
+};
+
+//Flat combining as a synchronization policy, the combiner runs the published operations one after another
+class FlatCombiningSync {
+public:
+	template <typename F>
+	std::invoke_result_t<F&> execute(F&& operation); //Publish operation and wait until it has run
+private:
+	struct Request {
+		void (*run)(void*); //Calls the published operation
+		void* operation; //Published operation
+		std::exception_ptr error; //Exception thrown by the operation
+		std::atomic<bool> done{false}; //Set by the combiner once the operation has run
+	};
+	bool servePass(); //Run the published operations once, returns whether there were any
+	PublicationSlots<Request> slots_; //Published operations
+};
+
+//Get the index of the calling thread
+inline int ThreadIndex::current() {
+	thread_local ThreadIndex index;
+	return index.index_;
+}
+
+//Constructor taking the lowest free index
+inline ThreadIndex::ThreadIndex() {
+	std::lock_guard<std::mutex> guard(registryMutex());
+	std::vector<bool>& taken = registry();
+	index_ = 0;
+	while (index_ < static_cast<int>(taken.size()) && taken[index_])
+		index_++; //Find the lowest free index
+	if (index_ == static_cast<int>(taken.size()))
+		taken.push_back(true);
+	else
+		taken[index_] = true;
+}
+
+//Destructor giving the index back
+inline ThreadIndex::~ThreadIndex() {
+	std::lock_guard<std::mutex> guard(registryMutex());
+	registry()[index_] = false;
+}
+
+//Get the lock guarding the registry
+inline std::mutex& ThreadIndex::registryMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+//Get which indices are taken
+inline std::vector<bool>& ThreadIndex::registry() {
+	static std::vector<bool> taken;
+	return taken;
+}
+
+//Get the next number of the calling thread
+inline uint32_t ThreadRandom::next() {
+	thread_local uint32_t state = 2463534242u ^ (static_cast<uint32_t>(ThreadIndex::current()) * 0x9E3779B9u);
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+//Wait a moment
+inline void SpinWait::wait() {
+	if (spins_ < SPINS_BEFORE_YIELD) {
+		spins_++;
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		_mm_pause(); //Tell the core it is a spin loop
+#endif
+		return;
+	}
+	std::this_thread::yield();
+}
+
+//Acquire the lock
+inline void SpinLockSync::lock() {
+	while (locked_.exchange(true, std::memory_order_acquire)) {
+		SpinWait spin;
+		while (locked_.load(std::memory_order_relaxed))
+			spin.wait(); //Spin on the cached flag without writing to it
+	}
+}
+
+//Acquire the lock if it is free, returns whether it was acquired
+inline bool SpinLockSync::try_lock() {
+	return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+}
+
+//Release the lock
+inline void SpinLockSync::unlock() {
+	locked_.store(false, std::memory_order_release);
+}
+
+//Run operation under the lock
+template <typename F>
+std::invoke_result_t<F&> SpinLockSync::execute(F&& operation) {
+	std::lock_guard<SpinLockSync> guard(*this);
+	return operation();
+}
+
+//Refresh the cached head after heap changed
+template <typename Heap>
+void LockedLanes<Heap>::Lane::updateTop() {
+	if constexpr (requires(const Heap& h) { h.isEmpty(); })
+		top.store(heap.isEmpty() ? EMPTY : heap.peekPriority(), std::memory_order_relaxed); //Backend of this repo
+	else
+		top.store(heap.empty() ? EMPTY : heap.min().priority, std::memory_order_relaxed); //MinHeap of nodes
+}
+
+//Constructor
+template <typename Heap>
+LockedLanes<Heap>::LockedLanes(int count) : lanes_(std::make_unique<Lane[]>(count)), count_(count) {}
+
+//Get lane at index
+template <typename Heap>
+typename LockedLanes<Heap>::Lane& LockedLanes<Heap>::operator[](int index) const {
+	return lanes_[index];
+}
+
+//Get number of lanes
+template <typename Heap>
+int LockedLanes<Heap>::count() const {
+	return count_;
+}
+
+//Get cached head of the lane at index
+template <typename Heap>
+long long LockedLanes<Heap>::top(int index) const {
+	return lanes_[index].top.load(std::memory_order_relaxed);
+}
+
+//Get the lane other than skip with the smallest cached head, or -1 if all looked empty
+template <typename Heap>
+int LockedLanes<Heap>::best(int skip) const {
+	int best = -1;
+	long long bestTop = EMPTY;
+	for (int i = 0; i < count_; i++) {
+		long long head = top(i);
+		if (i != skip && head < bestTop) {
+			bestTop = head;
+			best = i;
+		}
+	}
+	return best;
+}
+
+//Check every heap, the locked second look makes an empty answer certain
+template <typename Heap>
+bool LockedLanes<Heap>::allEmpty() const {
+	for (int i = 0; i < count_; i++)
+		if (top(i) != EMPTY)
+			return false;
+	return !untilLocked([](Lane& lane) { return lane.top.load(std::memory_order_relaxed) != EMPTY; });
+}
+
+//Run visit on the lanes one lock at a time until it returns true, returns whether it did
+//It is a consistent picture only while no other thread changes the lanes
+template <typename Heap>
+template <typename F>
+bool LockedLanes<Heap>::untilLocked(F&& visit) const {
+	for (int i = 0; i < count_; i++) {
+		std::lock_guard<SpinLockSync> guard(lanes_[i].lock);
+		if (visit(lanes_[i]))
+			return true;
+	}
+	return false;
+}
+
+//Run operation under the lock
+template <typename F>
+std::invoke_result_t<F&> MutexSync::execute(F&& operation) {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return operation();
+}
+
+//Publish request and combine or wait until it is done
+template <typename Request>
+template <typename Serve>
+void PublicationSlots<Request>::publishAndWait(Request& request, Serve&& servePass) {
+	int slot = threadSlot();
+	Request* empty = nullptr;
+	SpinWait publishing;
+	while (!slots_[slot].request.compare_exchange_weak(empty, &request, std::memory_order_release, std::memory_order_relaxed)) {
+		empty = nullptr;
+		slot = (slot + 1) % SLOTS; //Slot is taken by a thread sharing it, try the next one
+		if (slot == threadSlot())
+			publishing.wait(); //All slots are taken, wait for a combiner to free one
+	}
+	int used = slotsInUse_.load(std::memory_order_relaxed);
+	while (used <= slot && !slotsInUse_.compare_exchange_weak(used, slot + 1, std::memory_order_relaxed)) {
+	}
+	SpinWait waiting;
+	while (!request.done.load(std::memory_order_acquire)) {
+		if (!combining_.load(std::memory_order_relaxed) && !combining_.exchange(true, std::memory_order_acquire)) {
+			CombinerGuard guard{combining_};
+			for (int pass = 0; pass < COMBINING_PASSES; pass++)
+				if (!servePass())
+					break; //Our request is published, so the first pass always serves it
+		}
+		else
+			waiting.wait();
+	}
+}
+
+//Run operation as the combiner, without serving requests
+template <typename Request>
+template <typename F>
+std::invoke_result_t<F&> PublicationSlots<Request>::exclusive(F&& operation) {
+	SpinWait waiting;
+	while (combining_.load(std::memory_order_relaxed) || combining_.exchange(true, std::memory_order_acquire))
+		waiting.wait();
+	CombinerGuard guard{combining_};
+	return operation();
+}
+
+//Get the number of slots a pass has to scan
+template <typename Request>
+int PublicationSlots<Request>::used() const {
+	return slotsInUse_.load(std::memory_order_relaxed);
+}
+
+//Get the request waiting in slot, or nullptr
+template <typename Request>
+Request* PublicationSlots<Request>::published(int slot) const {
+	return slots_[slot].request.load(std::memory_order_acquire);
+}
+
+//Free slot and let the owner of request go on
+template <typename Request>
+void PublicationSlots<Request>::finish(int slot, Request* request) {
+	slots_[slot].request.store(nullptr, std::memory_order_relaxed); //Free the slot before the owner may leave
+	request->done.store(true, std::memory_order_release);
+}
+
+//Get the preferred slot of the calling thread
+template <typename Request>
+int PublicationSlots<Request>::threadSlot() {
+	return ThreadIndex::current() % SLOTS;
+}
+
+//Publish operation and wait until it has run
+template <typename F>
+std::invoke_result_t<F&> FlatCombiningSync::execute(F&& operation) {
+	using Result = std::invoke_result_t<F&>;
+	Request request;
+	if constexpr (std::is_void_v<Result>) {
+		request.run = [](void* published) { (*static_cast<std::remove_reference_t<F>*>(published))(); };
+		request.operation = &operation;
+		slots_.publishAndWait(request, [this] { return servePass(); });
+		if (request.error)
+			std::rethrow_exception(request.error); //Operation threw in the combiner
+	}
+	else {
+		std::optional<Result> result; //Filled by the combiner, the result need not be default-constructible
+		auto store = [&operation, &result]() { result.emplace(operation()); };
+		request.run = [](void* published) { (*static_cast<decltype(store)*>(published))(); };
+		request.operation = &store;
+		slots_.publishAndWait(request, [this] { return servePass(); });
+		if (request.error)
+			std::rethrow_exception(request.error); //Operation threw in the combiner
+		return std::move(*result);
+	}
+}
+
+//Run the published operations once, returns whether there were any
+inline bool FlatCombiningSync::servePass() {
+	bool served = false;
+	int used = slots_.used();
+	for (int i = 0; i < used; i++) {
+		Request* request = slots_.published(i);
+		if (!request)
+			continue;
+		try {
+			request->run(request->operation);
+		}
+		catch (...) {
+			request->error = std::current_exception();
+		}
+		slots_.finish(i, request);
+		served = true;
+	}
+	return served;
+}
+
+#endif // !CONCURRENT_SYNC_H
@@ -0,0 +1,134 @@
+#ifndef EPOCH_RECLAIMER_H
+#define EPOCH_RECLAIMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "ConcurrentSync.h"
+
+//Epoch-based reclamation after Fraser for lock-free structures
+//A thread reads shared nodes only between enter and exit, and a node taken out of the structure is retired
+//instead of deleted; it is deleted once the global epoch has moved on twice, since every thread that
+//could still see it has left the structure by then
+class EpochReclaimer {
+public:
+	EpochReclaimer(); //Constructor
+	~EpochReclaimer(); //Destructor deleting all retired nodes, no thread may be inside anymore
+	EpochReclaimer(const EpochReclaimer& other) = delete; //Retired nodes belong to one reclaimer
+	EpochReclaimer& operator=(const EpochReclaimer& other) = delete; //Retired nodes belong to one reclaimer
+	void enter(); //Start reading the structure, calls may be nested
+	void exit(); //Stop reading the structure
+	void retire(void* pointer, void (*destroy)(void*)); //Delete pointer with destroy once no thread can see it
+private:
+	static constexpr int MAX_THREADS = 256; //Threads that may use a reclaimer at the same time
+	static constexpr int RETIRED_BEFORE_COLLECT = 64; //Retired nodes of a thread before it tries to delete some
+	struct Retired {
+		void* pointer; //Retired node
+		void (*destroy)(void*); //Deletes the node
+		uint64_t epoch; //Global epoch when the node was retired
+	};
+	struct alignas(CACHE_LINE) ThreadRecord {
+		std::atomic<uint64_t> epoch{0}; //Epoch the thread entered in shifted left by one, bit 0 marks an active thread
+		int nesting = 0; //Depth of nested enter calls
+		std::vector<Retired> retired; //Nodes retired by the thread, oldest first
+	};
+	ThreadRecord& record(); //Get the record of the calling thread
+	bool tryAdvance(); //Move the global epoch on if every active thread has seen it
+	void collect(ThreadRecord& owner); //Delete the nodes of owner that no thread can see anymore
+	alignas(CACHE_LINE) std::atomic<uint64_t> globalEpoch_; //Current epoch
+	std::atomic<int> recordsInUse_; //Records before this index have been used
+	ThreadRecord records_[MAX_THREADS]; //Per-thread state
+};
+
+//Enters the reclaimer for the lifetime of the guard
+class EpochGuard {
+public:
+	explicit EpochGuard(EpochReclaimer& reclaimer) : reclaimer_(reclaimer) { reclaimer_.enter(); } //Constructor entering
+	~EpochGuard() { reclaimer_.exit(); } //Destructor leaving
+	EpochGuard(const EpochGuard& other) = delete; //Guards are not copied
+	EpochGuard& operator=(const EpochGuard& other) = delete; //Guards are not copied
+private:
+	EpochReclaimer& reclaimer_; //Entered reclaimer
+};
+
+//Constructor
+inline EpochReclaimer::EpochReclaimer() : globalEpoch_(1), recordsInUse_(0) {}
+
+//Destructor deleting all retired nodes, no thread may be inside anymore
+inline EpochReclaimer::~EpochReclaimer() {
+	for (ThreadRecord& owner : records_)
+		for (Retired& node : owner.retired)
+			node.destroy(node.pointer);
+}
+
+//Start reading the structure, calls may be nested
+inline void EpochReclaimer::enter() {
+	ThreadRecord& owner = record();
+	if (owner.nesting++ > 0)
+		return; //Already inside
+	uint64_t epoch = globalEpoch_.load(std::memory_order_relaxed);
+	while (true) {
+		owner.epoch.store((epoch << 1) | 1, std::memory_order_release);
+		std::atomic_thread_fence(std::memory_order_seq_cst); //Announce the epoch before reading any node
+		uint64_t current = globalEpoch_.load(std::memory_order_relaxed);
+		if (current == epoch)
+			return;
+		epoch = current; //Epoch moved on meanwhile, announce the new one so we do not hold it back
+	}
+}
+
+//Stop reading the structure
+inline void EpochReclaimer::exit() {
+	ThreadRecord& owner = record();
+	if (--owner.nesting == 0)
+		owner.epoch.store(0, std::memory_order_release);
+}
+
+//Delete pointer with destroy once no thread can see it
+inline void EpochReclaimer::retire(void* pointer, void (*destroy)(void*)) {
+	ThreadRecord& owner = record();
+	std::atomic_thread_fence(std::memory_order_seq_cst); //The unlinking store is ordered before reading the epoch
+	owner.retired.push_back(Retired{pointer, destroy, globalEpoch_.load(std::memory_order_relaxed)});
+	if (static_cast<int>(owner.retired.size()) % RETIRED_BEFORE_COLLECT == 0) {
+		tryAdvance();
+		collect(owner);
+	}
+}
+
+//Get the record of the calling thread
+inline EpochReclaimer::ThreadRecord& EpochReclaimer::record() {
+	int index = ThreadIndex::current();
+	if (index >= MAX_THREADS)
+		throw std::runtime_error("Too many threads for epoch reclamation"); //Check for a free record
+	int used = recordsInUse_.load(std::memory_order_relaxed);
+	while (used <= index && !recordsInUse_.compare_exchange_weak(used, index + 1, std::memory_order_relaxed)) {
+	}
+	return records_[index];
+}
+
+//Move the global epoch on if every active thread has seen it
+inline bool EpochReclaimer::tryAdvance() {
+	uint64_t epoch = globalEpoch_.load(std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst); //Pairs with the fence in enter
+	int used = recordsInUse_.load(std::memory_order_relaxed);
+	for (int i = 0; i < used; i++) {
+		uint64_t announced = records_[i].epoch.load(std::memory_order_acquire); //Reads of a thread that left happen before
+		if ((announced & 1) && (announced >> 1) != epoch)
+			return false; //Thread is still inside an older epoch
+	}
+	return globalEpoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+}
+
+//Delete the nodes of owner that no thread can see anymore
+inline void EpochReclaimer::collect(ThreadRecord& owner) {
+	uint64_t epoch = globalEpoch_.load(std::memory_order_acquire);
+	size_t freed = 0;
+	while (freed < owner.retired.size() && owner.retired[freed].epoch + 2 <= epoch) {
+		owner.retired[freed].destroy(owner.retired[freed].pointer);
+		freed++;
+	}
+	owner.retired.erase(owner.retired.begin(), owner.retired.begin() + freed);
+}
+
+#endif // !EPOCH_RECLAIMER_H
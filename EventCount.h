@@ -0,0 +1,123 @@
+#ifndef EVENT_COUNT_H
+#define EVENT_COUNT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+#include "ConcurrentSync.h"
+
+//Lets threads sleep until a condition they check themselves may have changed, without a lock around the condition
+//A waiter calls prepareWait, checks the condition once more and then either cancelWait or wait with the key;
+//a notifier changes the condition first and then calls notify, which skips the system call while nobody waits
+//On Linux the waiters sleep on a futex, so notify(count) wakes exactly count of them; elsewhere on a condition variable
+class EventCount {
+public:
+	using Clock = std::chrono::steady_clock;
+	EventCount(); //Constructor
+	EventCount(const EventCount& other) = delete; //Sleeping threads refer to the counter by address
+	EventCount& operator=(const EventCount& other) = delete; //Sleeping threads refer to the counter by address
+	uint32_t prepareWait(); //Announce a waiter, returns the key for wait
+	void cancelWait(); //Withdraw the announcement after the condition turned true
+	void wait(uint32_t key); //Sleep until notified after prepareWait returned key
+	bool waitUntil(uint32_t key, Clock::time_point deadline); //Sleep until notified or deadline, returns false on timeout
+	void notify(int count); //Wake up to count waiters
+	int waiters() const; //Get number of announced waiters
+private:
+	alignas(CACHE_LINE) std::atomic<uint32_t> epoch_; //Bumped by every notify that finds waiters, waiters sleep on it
+	std::atomic<int> waiters_; //Threads between prepareWait and the end of wait or cancelWait
+#if !defined(__linux__)
+	std::mutex mutex_; //Lock pairing with the condition variable
+	std::condition_variable changed_; //Signalled by notify
+#endif
+};
+
+//Constructor
+inline EventCount::EventCount() : epoch_(0), waiters_(0) {}
+
+//Announce a waiter, returns the key for wait
+inline uint32_t EventCount::prepareWait() {
+	waiters_.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst); //Pairs with the fence in notify, one side sees the other
+	return epoch_.load(std::memory_order_relaxed);
+}
+
+//Withdraw the announcement after the condition turned true
+inline void EventCount::cancelWait() {
+	waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//Sleep until notified after prepareWait returned key
+inline void EventCount::wait(uint32_t key) {
+	waitUntil(key, Clock::time_point::max());
+}
+
+//Sleep until notified or deadline, returns false on timeout
+inline bool EventCount::waitUntil(uint32_t key, Clock::time_point deadline) {
+	bool notified = true;
+#if defined(__linux__)
+	while (epoch_.load(std::memory_order_acquire) == key) {
+		timespec* timeout = nullptr;
+		timespec remaining;
+		if (deadline != Clock::time_point::max()) {
+			auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now()).count();
+			if (left <= 0) {
+				notified = false;
+				break;
+			}
+			remaining.tv_sec = static_cast<time_t>(left / 1000000000);
+			remaining.tv_nsec = static_cast<long>(left % 1000000000);
+			timeout = &remaining;
+		}
+		//Returns at once if the epoch already moved on, so a notify between the check and the call is not lost
+		::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, key, timeout, nullptr, 0);
+	}
+#else
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto moved = [this, key] { return epoch_.load(std::memory_order_acquire) != key; };
+		if (deadline == Clock::time_point::max())
+			changed_.wait(lock, moved);
+		else
+			notified = changed_.wait_until(lock, deadline, moved);
+	}
+#endif
+	waiters_.fetch_sub(1, std::memory_order_relaxed);
+	return notified;
+}
+
+//Wake up to count waiters
+inline void EventCount::notify(int count) {
+	std::atomic_thread_fence(std::memory_order_seq_cst); //The condition change is ordered before reading the waiters
+	if (count <= 0 || waiters_.load(std::memory_order_relaxed) == 0)
+		return; //Nobody to wake
+#if defined(__linux__)
+	epoch_.fetch_add(1, std::memory_order_release);
+	::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		epoch_.fetch_add(1, std::memory_order_release);
+	}
+	if (count >= waiters_.load(std::memory_order_relaxed))
+		changed_.notify_all();
+	else
+		for (int i = 0; i < count; i++)
+			changed_.notify_one();
+#endif
+}
+
+//Get number of announced waiters
+inline int EventCount::waiters() const {
+	return waiters_.load(std::memory_order_relaxed);
+}
+
+#endif // !EVENT_COUNT_H
@@ -0,0 +1,292 @@
+#ifndef EXTERNAL_RUN_H
+#define EXTERNAL_RUN_H
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//Record of a sorted run as it is laid out in the file
+template <typename T>
+struct ExternalRecord {
+	int priority;
+	T element;
+};
+
+//Writes records to a file through a large buffer, so the disk only sees long sequential writes
+template <typename T>
+class ExternalRunWriter {
+public:
+	ExternalRunWriter(const std::filesystem::path& path); //Constructor creating the file
+	~ExternalRunWriter(); //Destructor
+	ExternalRunWriter(const ExternalRunWriter& other) = delete; //Writers cannot be copied
+	ExternalRunWriter& operator=(const ExternalRunWriter& other) = delete; //Writers cannot be copied
+	void write(const ExternalRecord<T>& record); //Append record to the file
+	void write(const ExternalRecord<T>* records, size_t count); //Append block of records to the file
+	size_t close(); //Flush and close the file, returns number of records written
+private:
+	static constexpr size_t BUFFER_RECORDS = 65536; //Records gathered before a write
+	void flush(); //Write gathered records to the file
+	std::FILE* file_; //Open file
+	std::vector<ExternalRecord<T>> buffer_; //Records not written yet
+	size_t written_; //Number of records written so far
+};
+
+//Sorted run in a file, read front to back
+//On POSIX systems the file is memory-mapped and pages behind the read position are dropped as it advances,
+//elsewhere it is read in blocks through a small cache
+//Records can be marked dead, reading skips them
+template <typename T>
+class ExternalRun {
+	static_assert(std::is_trivially_copyable_v<T>, "Records are written to disk byte by byte");
+public:
+	ExternalRun(const std::filesystem::path& path, size_t count); //Constructor opening a run written before
+	~ExternalRun(); //Destructor removing the file
+	ExternalRun(const ExternalRun& other) = delete; //Runs cannot be copied
+	ExternalRun& operator=(const ExternalRun& other) = delete; //Runs cannot be copied
+	bool exhausted() const; //Check if every record has been read
+	size_t remaining() const; //Get number of records not read yet, dead ones included
+	const ExternalRecord<T>& head() const; //Get record at the read position
+	void advance(); //Move read position past the head and any dead records
+	long long find(const T& element) const; //Get position of unread live record holding element or -1
+	void kill(size_t position); //Mark unread record at position as dead
+	template <typename Visit>
+	void forEach(Visit&& visit) const; //Call visit with element and priority of every unread live record
+private:
+	static constexpr size_t BLOCK_RECORDS = 4096; //Records read at once without a mapping
+	static constexpr size_t RELEASE_BYTES = size_t(1) << 20; //Amount of read data dropped from memory at once
+	const ExternalRecord<T>& at(size_t position) const; //Get record at position
+	void skipDead(); //Move read position past dead records
+	void releaseRead(); //Let the system drop pages that have been read
+	std::filesystem::path path_; //Path of the file
+	size_t count_; //Number of records in the file
+	size_t position_; //Read position
+	std::unordered_set<size_t> dead_; //Positions of dead records not read yet
+#if defined(_WIN32)
+	std::FILE* file_; //Open file
+	mutable std::vector<ExternalRecord<T>> block_; //Cached block of records
+	mutable size_t blockStart_; //Position of the first cached record
+#else
+	int fd_; //Open file descriptor
+	ExternalRecord<T>* records_; //Mapping of the file
+	size_t released_; //Bytes at the beginning of the mapping already released
+#endif
+};
+
+//Constructor creating the file
+template <typename T>
+ExternalRunWriter<T>::ExternalRunWriter(const std::filesystem::path& path) : written_(0) {
+	file_ = std::fopen(path.string().c_str(), "wb");
+	if (!file_)
+		throw std::runtime_error("Cannot create run file " + path.string()); //Check if file was created
+	buffer_.reserve(BUFFER_RECORDS);
+}
+
+//Destructor
+template <typename T>
+ExternalRunWriter<T>::~ExternalRunWriter() {
+	if (file_)
+		std::fclose(file_);
+}
+
+//Append record to the file
+template <typename T>
+void ExternalRunWriter<T>::write(const ExternalRecord<T>& record) {
+	buffer_.push_back(record);
+	if (buffer_.size() == BUFFER_RECORDS)
+		flush(); //Buffer is full
+}
+
+//Append block of records to the file
+template <typename T>
+void ExternalRunWriter<T>::write(const ExternalRecord<T>* records, size_t count) {
+	flush(); //Keep records in order
+	if (std::fwrite(records, sizeof(ExternalRecord<T>), count, file_) != count)
+		throw std::runtime_error("Cannot write run file"); //Check for full disk
+	written_ += count;
+}
+
+//Flush and close the file, returns number of records written
+template <typename T>
+size_t ExternalRunWriter<T>::close() {
+	flush();
+	if (std::fclose(file_) != 0) {
+		file_ = nullptr;
+		throw std::runtime_error("Cannot write run file"); //Check if buffered data reached the disk
+	}
+	file_ = nullptr;
+	return written_;
+}
+
+//Write gathered records to the file
+template <typename T>
+void ExternalRunWriter<T>::flush() {
+	if (buffer_.empty())
+		return;
+	if (std::fwrite(buffer_.data(), sizeof(ExternalRecord<T>), buffer_.size(), file_) != buffer_.size())
+		throw std::runtime_error("Cannot write run file"); //Check for full disk
+	written_ += buffer_.size();
+	buffer_.clear();
+}
+
+#if defined(_WIN32)
+
+//Constructor opening a run written before
+template <typename T>
+ExternalRun<T>::ExternalRun(const std::filesystem::path& path, size_t count)
+	: path_(path), count_(count), position_(0), blockStart_(0) {
+	file_ = std::fopen(path.string().c_str(), "rb");
+	if (!file_)
+		throw std::runtime_error("Cannot open run file " + path.string()); //Check if file was opened
+}
+
+//Destructor removing the file
+template <typename T>
+ExternalRun<T>::~ExternalRun() {
+	std::fclose(file_);
+	std::error_code error;
+	std::filesystem::remove(path_, error); //File is temporary, failing to remove it is not fatal
+}
+
+//Get record at position
+template <typename T>
+const ExternalRecord<T>& ExternalRun<T>::at(size_t position) const {
+	if (position < blockStart_ || position >= blockStart_ + block_.size()) {
+		size_t length = count_ - position < BLOCK_RECORDS ? count_ - position : BLOCK_RECORDS;
+		block_.resize(length);
+		if (_fseeki64(file_, static_cast<long long>(position * sizeof(ExternalRecord<T>)), SEEK_SET) != 0 ||
+			std::fread(block_.data(), sizeof(ExternalRecord<T>), length, file_) != length)
+			throw std::runtime_error("Cannot read run file " + path_.string()); //Check for truncated file
+		blockStart_ = position;
+	}
+	return block_[position - blockStart_];
+}
+
+//Let the system drop pages that have been read
+template <typename T>
+void ExternalRun<T>::releaseRead() {}
+
+#else
+
+//Constructor opening a run written before
+template <typename T>
+ExternalRun<T>::ExternalRun(const std::filesystem::path& path, size_t count)
+	: path_(path), count_(count), position_(0), records_(nullptr), released_(0) {
+	fd_ = ::open(path.c_str(), O_RDONLY);
+	if (fd_ < 0)
+		throw std::runtime_error("Cannot open run file " + path.string()); //Check if file was opened
+	if (count_ == 0)
+		return; //Empty files cannot be mapped
+	void* mapping = ::mmap(nullptr, count_ * sizeof(ExternalRecord<T>), PROT_READ, MAP_PRIVATE, fd_, 0);
+	if (mapping == MAP_FAILED) {
+		::close(fd_);
+		throw std::runtime_error("Cannot map run file " + path.string()); //Check if file was mapped
+	}
+	::madvise(mapping, count_ * sizeof(ExternalRecord<T>), MADV_SEQUENTIAL); //Ask for aggressive read-ahead
+	records_ = static_cast<ExternalRecord<T>*>(mapping);
+}
+
+//Destructor removing the file
+template <typename T>
+ExternalRun<T>::~ExternalRun() {
+	if (records_)
+		::munmap(records_, count_ * sizeof(ExternalRecord<T>));
+	::close(fd_);
+	std::error_code error;
+	std::filesystem::remove(path_, error); //File is temporary, failing to remove it is not fatal
+}
+
+//Get record at position
+template <typename T>
+const ExternalRecord<T>& ExternalRun<T>::at(size_t position) const {
+	return records_[position];
+}
+
+//Let the system drop pages that have been read
+template <typename T>
+void ExternalRun<T>::releaseRead() {
+	size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	size_t read = position_ * sizeof(ExternalRecord<T>) / page * page; //Whole pages behind the read position
+	if (read - released_ < RELEASE_BYTES)
+		return;
+	::madvise(reinterpret_cast<char*>(records_) + released_, read - released_, MADV_DONTNEED);
+	released_ = read;
+}
+
+#endif
+
+//Check if every record has been read
+template <typename T>
+bool ExternalRun<T>::exhausted() const {
+	return position_ == count_;
+}
+
+//Get number of records not read yet, dead ones included
+template <typename T>
+size_t ExternalRun<T>::remaining() const {
+	return count_ - position_;
+}
+
+//Get record at the read position
+template <typename T>
+const ExternalRecord<T>& ExternalRun<T>::head() const {
+	return at(position_);
+}
+
+//Move read position past the head and any dead records
+template <typename T>
+void ExternalRun<T>::advance() {
+	position_++;
+	skipDead();
+	releaseRead();
+}
+
+//Get position of unread live record holding element or -1
+template <typename T>
+long long ExternalRun<T>::find(const T& element) const {
+	for (size_t i = position_; i < count_; i++) {
+		if (at(i).element == element && dead_.count(i) == 0)
+			return static_cast<long long>(i);
+	}
+	return -1;
+}
+
+//Mark unread record at position as dead
+template <typename T>
+void ExternalRun<T>::kill(size_t position) {
+	dead_.insert(position);
+	skipDead();
+}
+
+//Call visit with element and priority of every unread live record
+template <typename T>
+template <typename Visit>
+void ExternalRun<T>::forEach(Visit&& visit) const {
+	for (size_t i = position_; i < count_; i++) {
+		if (dead_.count(i) == 0)
+			visit(at(i).element, at(i).priority);
+	}
+}
+
+//Move read position past dead records
+template <typename T>
+void ExternalRun<T>::skipDead() {
+	while (position_ < count_ && !dead_.empty()) {
+		auto it = dead_.find(position_);
+		if (it == dead_.end())
+			break;
+		dead_.erase(it);
+		position_++;
+	}
+}
+
+#endif // !EXTERNAL_RUN_H
@@ -0,0 +1,122 @@
+#ifndef HIERARCHICAL_BITMAP_H
+#define HIERARCHICAL_BITMAP_H
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+//Bitmap over [0, universe) with a summary level per 64 words, so the next set bit is found
+//with one find-first-set per level instead of a scan over the whole bitmap
+class HierarchicalBitmap {
+public:
+	HierarchicalBitmap(int universe); //Constructor with number of indexable bits
+	void set(int index); //Set bit at index
+	void reset(int index); //Clear bit at index
+	bool test(int index) const; //Check if bit at index is set
+	int findFirst() const; //Get index of the first set bit or -1
+	int findNext(int index) const; //Get index of the first set bit not smaller than index or -1
+	bool empty() const; //Check if no bit is set
+	void clear(); //Clear all bits
+	int universe() const; //Get number of indexable bits
+private:
+	int findNext(int level, int index) const; //Search for the first set bit on given level
+	std::vector<std::vector<uint64_t>> levels_; //Level 0 holds the bits, level k summarizes words of level k - 1
+	int universe_; //Number of indexable bits
+};
+
+//Constructor with number of indexable bits
+inline HierarchicalBitmap::HierarchicalBitmap(int universe) : universe_(universe) {
+	if (universe <= 0)
+		throw std::out_of_range("Bitmap universe must be positive"); //Check for empty universe
+	int bits = universe;
+	do {
+		int words = (bits + 63) / 64; //Number of words needed on this level
+		levels_.emplace_back(words, 0);
+		bits = words;
+	} while (bits > 1);
+}
+
+//Set bit at index
+inline void HierarchicalBitmap::set(int index) {
+	if (index < 0 || index >= universe_)
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	for (auto& level : levels_) {
+		uint64_t& word = level[index >> 6];
+		bool wasEmpty = word == 0;
+		word |= uint64_t(1) << (index & 63); //Mark bit on this level
+		if (!wasEmpty)
+			break; //Upper levels already know about this word
+		index >>= 6;
+	}
+}
+
+//Clear bit at index
+inline void HierarchicalBitmap::reset(int index) {
+	if (index < 0 || index >= universe_)
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	for (auto& level : levels_) {
+		uint64_t& word = level[index >> 6];
+		word &= ~(uint64_t(1) << (index & 63)); //Clear bit on this level
+		if (word != 0)
+			break; //Word still has other bits so upper levels stay set
+		index >>= 6;
+	}
+}
+
+//Check if bit at index is set
+inline bool HierarchicalBitmap::test(int index) const {
+	if (index < 0 || index >= universe_)
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	return (levels_[0][index >> 6] >> (index & 63)) & 1;
+}
+
+//Get index of the first set bit or -1
+inline int HierarchicalBitmap::findFirst() const {
+	return findNext(0);
+}
+
+//Get index of the first set bit not smaller than index or -1
+inline int HierarchicalBitmap::findNext(int index) const {
+	if (index < 0)
+		index = 0;
+	if (index >= universe_)
+		return -1;
+	return findNext(0, index);
+}
+
+//Search for the first set bit on given level, descending through the summary when the word is exhausted
+inline int HierarchicalBitmap::findNext(int level, int index) const {
+	const std::vector<uint64_t>& bits = levels_[level];
+	int word = index >> 6;
+	if (word >= static_cast<int>(bits.size()))
+		return -1;
+	uint64_t masked = bits[word] & (~uint64_t(0) << (index & 63)); //Drop bits below index
+	if (masked != 0)
+		return (word << 6) + std::countr_zero(masked);
+	if (level + 1 == static_cast<int>(levels_.size()))
+		return -1; //Top level has a single word
+	int nextWord = findNext(level + 1, word + 1); //Ask summary for the next non-empty word
+	if (nextWord < 0)
+		return -1;
+	return (nextWord << 6) + std::countr_zero(bits[nextWord]);
+}
+
+//Check if no bit is set
+inline bool HierarchicalBitmap::empty() const {
+	return levels_.back()[0] == 0;
+}
+
+//Clear all bits
+inline void HierarchicalBitmap::clear() {
+	for (auto& level : levels_)
+		for (auto& word : level)
+			word = 0;
+}
+
+//Get number of indexable bits
+inline int HierarchicalBitmap::universe() const {
+	return universe_;
+}
+
+#endif // !HIERARCHICAL_BITMAP_H
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "ConcurrentSync.h"
+#include "MpscRing.h"
+
+#ifndef SD_P2_INGESTIONPRIORITYQUEUE_H
+#define SD_P2_INGESTIONPRIORITYQUEUE_H
+
+//Many producers, one consumer in front of any single-threaded backend
+//Producers never touch the backend: each one pushes into its own lock-free ring, picked by ThreadIndex,
+//and only if that ring is full does it fall back to an overflow list under a lock
+//The consumer, called the dispatcher, moves everything waiting in the rings into the backend with one enqueueBulk
+//before every call that reads the backend, so a heap backend takes a large batch with a Floyd rebuild
+//enqueue may be called from any thread, every other call only from the dispatcher thread
+template <typename Backend>
+class IngestionPriorityQueue : public PriorityQueue<typename Backend::value_type> {
+public:
+    using T = typename Backend::value_type;
+
+private:
+    using Ring = MpscRing<SnapshotEntry<T>>;
+
+    mutable Backend backend;
+    std::unique_ptr<std::unique_ptr<Ring>[]> rings;
+    int ringCount;
+    mutable std::mutex overflowLock;
+    mutable std::vector<SnapshotEntry<T>> overflow;
+    mutable std::atomic<int> overflowCount;
+    mutable std::vector<SnapshotEntry<T>> batch; //Reused between drains so it keeps its capacity
+    std::atomic<int> size;
+
+    //Moving waiting elements into the backend does not change the contents of the queue, so it is done in const calls
+    void drain() const {
+        for (int i = 0; i < ringCount; i++) {
+            rings[i]->drain([this](SnapshotEntry<T>&& entry) { batch.push_back(std::move(entry)); });
+        }
+        if (overflowCount.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> guard(overflowLock);
+            for (SnapshotEntry<T>& entry : overflow) {
+                batch.push_back(std::move(entry));
+            }
+            overflow.clear();
+            overflowCount.store(0, std::memory_order_relaxed);
+        }
+        if (batch.empty()) return;
+        backend.enqueueBulk(batch);
+        batch.clear();
+    }
+
+public:
+    //One ring per producer running at the same time, each with room for ringCapacity elements
+    explicit IngestionPriorityQueue(int producers = static_cast<int>(std::thread::hardware_concurrency()), int ringCapacity = 1024)
+        : overflowCount(0), size(0) {
+        ringCount = std::max(1, producers);
+        rings = std::make_unique<std::unique_ptr<Ring>[]>(ringCount);
+        for (int i = 0; i < ringCount; i++) {
+            rings[i] = std::make_unique<Ring>(ringCapacity);
+        }
+    }
+
+    IngestionPriorityQueue(const IngestionPriorityQueue&) = delete;
+    IngestionPriorityQueue& operator=(const IngestionPriorityQueue&) = delete;
+
+    int producerCount() const {
+        return ringCount;
+    }
+
+    //Safe from any thread
+    void enqueue(T element, int priority) override {
+        size.fetch_add(1, std::memory_order_relaxed);
+        Ring& ring = *rings[ThreadIndex::current() % ringCount];
+        SnapshotEntry<T> entry{priority, std::move(element)};
+        if (ring.tryPush(std::move(entry))) return;
+        std::lock_guard<std::mutex> guard(overflowLock);
+        overflow.push_back(std::move(entry));
+        overflowCount.store(static_cast<int>(overflow.size()), std::memory_order_release);
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes the most urgent element into element, returns false if the queue is empty
+    //An enqueue that has not finished pushing yet may be missed
+    bool tryDequeue(T& element) {
+        drain();
+        if (backend.isEmpty()) return false;
+        element = backend.dequeue();
+        size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    T peek() const override {
+        drain();
+        return backend.peek();
+    }
+
+    int peekPriority() const override {
+        drain();
+        return backend.peekPriority();
+    }
+
+    //Counts enqueues as soon as they start, so it may run ahead of what the dispatcher can dequeue yet
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        drain();
+        backend.modifyPriority(std::move(element), newPriority);
+    }
+
+    bool isEmpty() const override {
+        drain();
+        return backend.isEmpty();
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        drain();
+        backend.forEachEntry(visit);
+    }
+
+protected:
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        drain();
+        size.fetch_add(static_cast<int>(entries.size()), std::memory_order_relaxed);
+        backend.enqueueBulk(entries);
+    }
+};
+
+#endif //SD_P2_INGESTIONPRIORITYQUEUE_H
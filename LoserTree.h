@@ -0,0 +1,116 @@
+#ifndef LOSER_TREE_H
+#define LOSER_TREE_H
+
+#include <vector>
+
+//Tournament tree of losers for merging k sorted sequences
+//Internal nodes remember the loser of their match and the overall winner is kept apart, so after the winner's
+//sequence advances only the matches on its path to the root are replayed – one comparison per level
+//Ties are won by the sequence with the lower index
+template <typename Key>
+class LoserTree {
+public:
+	LoserTree() = default; //Default constructor
+	void build(const std::vector<Key>& keys, const std::vector<bool>& active); //Start a tournament over the heads of the sequences
+	int winner() const; //Get index of the sequence with the smallest head or -1 if all are exhausted
+	const Key& winnerKey() const; //Get head of the winning sequence
+	void replace(const Key& key); //Give the winner a new head and replay its path
+	void exhaust(); //Mark the winner as exhausted and replay its path
+private:
+	bool beats(int first, int second) const; //Check if sequence first wins against sequence second
+	int play(int node); //Fill the subtree of node with losers and return its winner
+	void replay(); //Replay the matches from the winner's leaf to the root
+	std::vector<Key> keys_; //Current head of every sequence
+	std::vector<bool> active_; //Whether a sequence still has a head
+	std::vector<int> losers_; //Loser of the match at every internal node, node 0 holds the winner
+	int leaves_ = 0; //Number of leaves, a power of two not smaller than the number of sequences
+	int sources_ = 0; //Number of sequences
+};
+
+//Start a tournament over the heads of the sequences
+template <typename Key>
+void LoserTree<Key>::build(const std::vector<Key>& keys, const std::vector<bool>& active) {
+	sources_ = static_cast<int>(keys.size());
+	leaves_ = 1;
+	while (leaves_ < sources_)
+		leaves_ <<= 1;
+	keys_ = keys;
+	active_ = active;
+	keys_.resize(leaves_); //Padding leaves are exhausted sequences
+	active_.resize(leaves_, false);
+	losers_.assign(leaves_, -1);
+	losers_[0] = sources_ == 0 ? -1 : play(1);
+}
+
+//Get index of the sequence with the smallest head or -1 if all are exhausted
+template <typename Key>
+int LoserTree<Key>::winner() const {
+	if (losers_.empty() || losers_[0] < 0 || !active_[losers_[0]])
+		return -1;
+	return losers_[0];
+}
+
+//Get head of the winning sequence
+template <typename Key>
+const Key& LoserTree<Key>::winnerKey() const {
+	return keys_[losers_[0]];
+}
+
+//Give the winner a new head and replay its path
+template <typename Key>
+void LoserTree<Key>::replace(const Key& key) {
+	keys_[losers_[0]] = key;
+	replay();
+}
+
+//Mark the winner as exhausted and replay its path
+template <typename Key>
+void LoserTree<Key>::exhaust() {
+	active_[losers_[0]] = false;
+	replay();
+}
+
+//Check if sequence first wins against sequence second
+template <typename Key>
+bool LoserTree<Key>::beats(int first, int second) const {
+	if (active_[first] != active_[second])
+		return active_[first]; //Exhausted sequences lose against everything
+	if (!active_[first])
+		return first < second;
+	if (keys_[first] < keys_[second])
+		return true;
+	if (keys_[second] < keys_[first])
+		return false;
+	return first < second;
+}
+
+//Fill the subtree of node with losers and return its winner
+template <typename Key>
+int LoserTree<Key>::play(int node) {
+	if (node >= leaves_)
+		return node - leaves_; //Leaf stands for its sequence
+	int left = play(2 * node);
+	int right = play(2 * node + 1);
+	if (beats(left, right)) {
+		losers_[node] = right;
+		return left;
+	}
+	losers_[node] = left;
+	return right;
+}
+
+//Replay the matches from the winner's leaf to the root
+template <typename Key>
+void LoserTree<Key>::replay() {
+	int winner = losers_[0];
+	for (int node = (winner + leaves_) / 2; node > 0; node /= 2) {
+		if (beats(losers_[node], winner)) {
+			int loser = winner;
+			winner = losers_[node];
+			losers_[node] = loser;
+		}
+	}
+	losers_[0] = winner;
+}
+
+#endif // !LOSER_TREE_H
@@ -0,0 +1,293 @@
+#ifndef MAPPED_ARRAY_H
+#define MAPPED_ARRAY_H
+
+#if !defined(_WIN32)
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Array with the interface of DynamicArray whose elements live in a memory-mapped file
+//The file starts with a small header holding the size, so opening an existing file restores the array
+//without reading or converting anything – the pages are loaded by the system when they are touched
+//Growing extends the file with ftruncate and the mapping with mremap on Linux, or by mapping it again elsewhere
+//Elements are stored byte by byte and therefore have to be trivially copyable
+template <typename T>
+class MappedArray {
+	static_assert(std::is_trivially_copyable_v<T>, "Elements are stored in the file byte by byte");
+	static_assert(alignof(T) <= 16, "Elements are placed 16 bytes behind the page-aligned start of the mapping");
+public:
+	MappedArray(const std::string& path); //Constructor opening or creating the file
+	~MappedArray(); //Destructor
+	MappedArray(const MappedArray& other) = delete; //Mappings cannot be copied
+	MappedArray& operator=(const MappedArray& other) = delete; //Mappings cannot be copied
+	void pushBack(const T& element); //Add element to the end
+	void popBack(); //Remove last element
+	void popFront(); //Remove first element
+	void insert(int index, const T& element); //Insert element at index
+	void remove(int index); //Remove element at index
+	void clear(); //Clear the array
+	T& at(int index); //Get element at index
+	T& operator[](int index); //Overload [] operator for non-const access
+	const T& operator[](int index) const; //Overload [] operator for const access
+	const T& get(int index) const; //Get element at index (const version)
+	const T& back() const; //Get last element (const version)
+	const T& front() const; //Get first element (const version)
+	int size() const; //Get size of the array
+	int capacity() const; //Get capacity of the array
+	bool empty() const; //Check if the array is empty
+	int find(const T& element) const; //Find element in the array
+	bool contains(const T& element) const; //Check if the array contains element
+	void resize(); //Resize the array if needed
+	void sync(); //Write changed pages to the file and wait for it
+private:
+	struct Header {
+		char magic[4]; //Always "SDMA"
+		uint32_t elementSize; //Size of an element the file was written with
+		int64_t size; //Number of elements
+	};
+	static constexpr int DEFAULT_CAPACITY = 1024; //Capacity of a new file
+	static size_t bytesFor(int capacity); //Get file size holding capacity elements
+	void map(size_t bytes); //Extend the file to bytes and map it
+	Header* header() const; //Get header at the beginning of the mapping
+	T* elements() const; //Get first element behind the header
+	int fd_; //Open file descriptor
+	void* mapping_; //Start of the mapping
+	size_t mappedBytes_; //Length of the mapping
+	int capacity_; //Number of elements fitting into the mapping
+};
+
+//Constructor opening or creating the file
+template <typename T>
+MappedArray<T>::MappedArray(const std::string& path) : mapping_(nullptr), mappedBytes_(0), capacity_(0) {
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd_ < 0)
+		throw std::runtime_error("Cannot open " + path); //Check if file was opened
+	struct stat info;
+	if (::fstat(fd_, &info) != 0) {
+		::close(fd_);
+		throw std::runtime_error("Cannot read size of " + path); //Check if size is known
+	}
+	size_t bytes = static_cast<size_t>(info.st_size);
+	bool created = bytes == 0;
+	if (!created && bytes < bytesFor(0)) {
+		::close(fd_);
+		throw std::runtime_error("Not a mapped array: " + path); //Check for truncated header
+	}
+	try {
+		map(created ? bytesFor(DEFAULT_CAPACITY) : bytes);
+	}
+	catch (...) {
+		::close(fd_);
+		throw;
+	}
+	if (created) {
+		std::memcpy(header()->magic, "SDMA", 4);
+		header()->elementSize = sizeof(T);
+		header()->size = 0;
+	}
+	else if (std::memcmp(header()->magic, "SDMA", 4) != 0 || header()->elementSize != sizeof(T) ||
+		header()->size < 0 || header()->size > capacity_) {
+		::munmap(mapping_, mappedBytes_);
+		::close(fd_);
+		throw std::runtime_error("Not a mapped array of this element type: " + path); //Check header
+	}
+}
+
+//Destructor
+template <typename T>
+MappedArray<T>::~MappedArray() {
+	::munmap(mapping_, mappedBytes_); //Dirty pages reach the file through the page cache
+	::close(fd_);
+}
+
+//Add element to the end
+template <typename T>
+void MappedArray<T>::pushBack(const T& element) {
+	if (size() == capacity_)
+		resize(); //Resize if needed
+	elements()[header()->size++] = element; //Add element
+}
+
+//Remove last element
+template <typename T>
+void MappedArray<T>::popBack() {
+	if (empty())
+		throw std::out_of_range("Array is empty"); //Check if array is empty
+	header()->size--; //Decrease size
+}
+
+//Remove first element
+template <typename T>
+void MappedArray<T>::popFront() {
+	remove(0); //Remove first element
+}
+
+//Insert element at index
+template <typename T>
+void MappedArray<T>::insert(int index, const T& element) {
+	if (index < 0 || index > size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	if (size() == capacity_)
+		resize(); //Resize if needed
+	std::memmove(elements() + index + 1, elements() + index, (size() - index) * sizeof(T)); //Shift elements right
+	elements()[index] = element; //Insert element
+	header()->size++; //Increase size
+}
+
+//Remove element at index
+template <typename T>
+void MappedArray<T>::remove(int index) {
+	if (index < 0 || index >= size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	std::memmove(elements() + index, elements() + index + 1, (size() - index - 1) * sizeof(T)); //Shift elements left
+	header()->size--; //Decrease size
+}
+
+//Clear the array
+template <typename T>
+void MappedArray<T>::clear() {
+	header()->size = 0; //Set size to 0
+}
+
+//Get element at index
+template <typename T>
+T& MappedArray<T>::at(int index) {
+	if (index < 0 || index >= size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	return elements()[index]; //Return element at index
+}
+
+//Overload [] operator for non-const access
+template <typename T>
+T& MappedArray<T>::operator[](int index) {
+	return elements()[index]; //Return element at index
+}
+
+//Overload [] operator for const access
+template <typename T>
+const T& MappedArray<T>::operator[](int index) const {
+	return elements()[index]; //Return element at index
+}
+
+//Get element at index (const version)
+template <typename T>
+const T& MappedArray<T>::get(int index) const {
+	if (index < 0 || index >= size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	return elements()[index]; //Return element at index
+}
+
+//Get last element (const version)
+template <typename T>
+const T& MappedArray<T>::back() const {
+	if (empty())
+		throw std::out_of_range("Array is empty"); //Check if array is empty
+	return elements()[size() - 1]; //Return last element
+}
+
+//Get first element (const version)
+template <typename T>
+const T& MappedArray<T>::front() const {
+	if (empty())
+		throw std::out_of_range("Array is empty"); //Check if array is empty
+	return elements()[0]; //Return first element
+}
+
+//Get size of the array
+template <typename T>
+int MappedArray<T>::size() const {
+	return static_cast<int>(header()->size); //Return size
+}
+
+//Get capacity of the array
+template <typename T>
+int MappedArray<T>::capacity() const {
+	return capacity_; //Return capacity
+}
+
+//Check if the array is empty
+template <typename T>
+bool MappedArray<T>::empty() const {
+	return header()->size == 0; //Check if array is empty
+}
+
+//Find element in the array
+template <typename T>
+int MappedArray<T>::find(const T& element) const {
+	for (int i = 0; i < size(); i++)
+		if (elements()[i] == element)
+			return i; //Return index of element
+	return -1; //Element not found
+}
+
+//Check if the array contains element
+template <typename T>
+bool MappedArray<T>::contains(const T& element) const {
+	return find(element) != -1; //Check if element is found
+}
+
+//Resize the array if needed
+template <typename T>
+void MappedArray<T>::resize() {
+	map(bytesFor(capacity_ > 0 ? capacity_ * 2 : DEFAULT_CAPACITY)); //Double the capacity, a file holding only the header starts over
+}
+
+//Write changed pages to the file and wait for it
+template <typename T>
+void MappedArray<T>::sync() {
+	if (::msync(mapping_, mappedBytes_, MS_SYNC) != 0)
+		throw std::runtime_error("Cannot write mapped array"); //Check for I/O error
+}
+
+//Get file size holding capacity elements
+template <typename T>
+size_t MappedArray<T>::bytesFor(int capacity) {
+	return sizeof(Header) + static_cast<size_t>(capacity) * sizeof(T);
+}
+
+//Extend the file to bytes and map it
+template <typename T>
+void MappedArray<T>::map(size_t bytes) {
+	if (bytes > mappedBytes_ && ::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+		throw std::runtime_error("Cannot extend mapped array"); //Check for full disk
+	void* mapping;
+	if (!mapping_)
+		mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	else {
+#if defined(__linux__)
+		mapping = ::mremap(mapping_, mappedBytes_, bytes, MREMAP_MAYMOVE); //Grow in place or move the page tables
+#else
+		mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+		if (mapping != MAP_FAILED)
+			::munmap(mapping_, mappedBytes_);
+#endif
+	}
+	if (mapping == MAP_FAILED)
+		throw std::runtime_error("Cannot map array"); //Check if mapping succeeded
+	mapping_ = mapping;
+	mappedBytes_ = bytes;
+	capacity_ = static_cast<int>((bytes - sizeof(Header)) / sizeof(T));
+}
+
+//Get header at the beginning of the mapping
+template <typename T>
+typename MappedArray<T>::Header* MappedArray<T>::header() const {
+	return static_cast<Header*>(mapping_);
+}
+
+//Get first element behind the header
+template <typename T>
+T* MappedArray<T>::elements() const {
+	return reinterpret_cast<T*>(static_cast<char*>(mapping_) + sizeof(Header));
+}
+
+#endif // !_WIN32
+
+#endif // !MAPPED_ARRAY_H
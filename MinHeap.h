@@ -1,14 +1,18 @@
 ﻿#ifndef MINHEAP_H
 #define MINHEAP_H
 
+#include <utility>
 #include "DynamicArray.h"
 
 //Minimum heap class template
-template <typename T>
+//Storage has to provide the interface of DynamicArray, see MappedArray for a file-backed one
+template <typename T, typename Storage = DynamicArray<T>>
 class MinHeap {
 public:
 	MinHeap() = default; //Default constructor
 	MinHeap(int capacity); //Constructor with initial capacity
+	template <typename... Args>
+	explicit MinHeap(std::in_place_t, Args&&... args); //Constructor passing arguments on to the storage
 	~MinHeap() = default; //Destructor
 	void insert(const T& element); //Insert element into the heap
 	void removeMin(); //Remove minimum element from the heap
@@ -20,32 +24,45 @@ public:
 	void replace(int index, const T& element); //Replace element at index
 	const T& get(int index) const; //Get element at index (const version)
 	int size() const; //Get size of the heap
+	template <typename Source>
+	void insertBulk(const Source& elements); //Insert all elements of an array into the heap
+	void merge(MinHeap& other); //Move all elements of other heap into this heap
+	void clear(); //Remove all elements from the heap
+	template <typename Source>
+	void assign(const Source& elements); //Replace contents with the elements of an array, keeping their order if it already is a heap
 private:
+	bool isHeap() const; //Check if the whole array satisfies the heap property
+	void buildHeap(); //Restore heap property of the whole array (Floyd)
 	void heapifyUp(); //Heapify up operation
 	void heapifyUp(int index); //Heapify up operation with index
 	void heapifyDown(); //Heapify down operation
 	void heapifyDown(int index); //Heapify down operation with index
-	DynamicArray<T> heap_; //Dynamic array to store heap elements
+	Storage heap_; //Dynamic array to store heap elements
 };
 
 //Constructor with initial capacity
-template <typename T>
-MinHeap<T>::MinHeap(int capacity) {
+template <typename T, typename Storage>
+MinHeap<T, Storage>::MinHeap(int capacity) {
 	if (capacity < 0)
 		throw std::out_of_range("Given capacity is negative"); //Check for negative capacity
-	heap_ = DynamicArray<T>(capacity); //Initialize heap with given capacity
+	heap_ = Storage(capacity); //Initialize heap with given capacity
 }
 
+//Constructor passing arguments on to the storage
+template <typename T, typename Storage>
+template <typename... Args>
+MinHeap<T, Storage>::MinHeap(std::in_place_t, Args&&... args) : heap_(std::forward<Args>(args)...) {}
+
 //Destructor
-template <typename T>
-void MinHeap<T>::insert(const T& element) {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::insert(const T& element) {
 	heap_.pushBack(element); //Add element to the end
 	heapifyUp(); //Heapify up to maintain heap property
 }
 
 //Insert element into the heap
-template <typename T>
-void MinHeap<T>::removeMin() {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::removeMin() {
 	if (heap_.empty())
 		throw std::out_of_range("Heap is empty"); //Check if heap is empty
 	std::swap(heap_[0], heap_[heap_.size() - 1]); //Swap minimum element with last element
@@ -54,47 +71,49 @@ void MinHeap<T>::removeMin() {
 }
 
 //Remove minimum element from the heap
-template <typename T>
-T MinHeap<T>::extractMin() {
+template <typename T, typename Storage>
+T MinHeap<T, Storage>::extractMin() {
 	T minimal = min(); //Get minimum element
 	removeMin(); //Remove minimum element
 	return minimal; //Return minimum element
 }
 
 //Extract minimum element from the heap
-template <typename T>
-const T& MinHeap<T>::min() const {
+template <typename T, typename Storage>
+const T& MinHeap<T, Storage>::min() const {
 	if (heap_.empty())
 		throw std::out_of_range("Heap is empty"); //Check if heap is empty
 	return heap_.front(); //Return minimum element
 }
 
 //Check if the heap is empty
-template <typename T>
-bool MinHeap<T>::empty() const {
+template <typename T, typename Storage>
+bool MinHeap<T, Storage>::empty() const {
 	return heap_.empty(); //Check if heap is empty
 }
 
 //Find element in the heap
-template <typename T>
-int MinHeap<T>::find(const T& element) const {
+template <typename T, typename Storage>
+int MinHeap<T, Storage>::find(const T& element) const {
 	return heap_.find(element); //Find element in the heap
 }
 
 //Remove element at index
-template <typename T>
-void MinHeap<T>::remove(int index) {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::remove(int index) {
 	if (index < 0 || index >= heap_.size())
 		throw std::out_of_range("Index out of range"); //Check for valid index
 	std::swap(heap_[index], heap_[heap_.size() - 1]); //Swap with last element
 	heap_.popBack(); //Remove last element
+	if (index == heap_.size())
+		return; //Removed element was the last one, nothing moved
 	heapifyDown(index); //Heapify down to maintain heap property
 	heapifyUp(index); //Heapify up to maintain heap property
 }
 
 //Replace element at index
-template <typename T>
-void MinHeap<T>::replace(int index, const T& element) {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::replace(int index, const T& element) {
 	if (index < 0 || index >= heap_.size())
 		throw std::out_of_range("Index out of range"); //Check for valid index
 	T oldElement = heap_[index]; //Store old element
@@ -106,22 +125,22 @@ void MinHeap<T>::replace(int index, const T& element) {
 }
 
 //Get element at index (const version)
-template <typename T>
-const T& MinHeap<T>::get(int index) const {
+template <typename T, typename Storage>
+const T& MinHeap<T, Storage>::get(int index) const {
 	if (index < 0 || index >= heap_.size())
 		throw std::out_of_range("Index out of range"); //Check for valid index
 	return heap_[index]; //Return element at index
 }
 
 //Get size of the heap
-template <typename T>
-int MinHeap<T>::size() const {
+template <typename T, typename Storage>
+int MinHeap<T, Storage>::size() const {
 	return heap_.size(); //Get size of the heap
 }
 
 //Heapify up operation
-template <typename T>
-void MinHeap<T>::heapifyUp() {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::heapifyUp() {
 	int i = heap_.size() - 1; //Start from the last element
 	while (i > 0) {
 		int parent = (i - 1) / 2; //Get parent index
@@ -135,8 +154,8 @@ void MinHeap<T>::heapifyUp() {
 }
 
 //Heapify up operation with index
-template <typename T>
-void MinHeap<T>::heapifyUp(int index) {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::heapifyUp(int index) {
 	if (index < 0 || index >= heap_.size())
 		throw std::out_of_range("Index out of range"); //Check for valid index
 	int i = index; //Start from the given index
@@ -152,8 +171,8 @@ void MinHeap<T>::heapifyUp(int index) {
 }
 
 //Heapify down operation
-template <typename T>
-void MinHeap<T>::heapifyDown() {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::heapifyDown() {
 	int size = heap_.size(); //Get size of heap
 	int i = 0; //Start from the root
 	while (2 * i + 1 < size) {
@@ -175,8 +194,8 @@ void MinHeap<T>::heapifyDown() {
 }
 
 //Heapify down operation with index
-template <typename T>
-void MinHeap<T>::heapifyDown(int index) {
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::heapifyDown(int index) {
 	if (index < 0 || index >= heap_.size())
 		throw std::out_of_range("Index out of range"); //Check for valid index
 	int size = heap_.size(); //Get size of heap
@@ -198,5 +217,69 @@ void MinHeap<T>::heapifyDown(int index) {
 	}
 }
 
+//Insert all elements of an array into the heap
+//A large batch is appended and the whole heap rebuilt in O(n), a small one is sifted up element by element
+//Source is any array with size() and operator[], a DynamicArray or another heap's storage
+template <typename T, typename Storage>
+template <typename Source>
+void MinHeap<T, Storage>::insertBulk(const Source& elements) {
+	int count = elements.size(); //Number of inserted elements
+	if (count == 0)
+		return;
+	int total = heap_.size() + count; //Size after insertion
+	int depth = 1; //Height of the resulting heap
+	while ((1 << depth) <= total)
+		depth++;
+	bool rebuild = static_cast<long long>(count) * depth >= total; //Sifting each element would cost more than Floyd
+	for (int i = 0; i < count; i++) {
+		heap_.pushBack(elements[i]); //Append element
+		if (!rebuild)
+			heapifyUp(); //Heapify up to maintain heap property
+	}
+	if (rebuild)
+		buildHeap(); //Rebuild heap bottom-up
+}
+
+//Move all elements of other heap into this heap
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::merge(MinHeap& other) {
+	if (this == &other)
+		return;
+	insertBulk(other.heap_); //Insert elements of other heap
+	other.clear(); //Other heap is left empty
+}
+
+//Remove all elements from the heap
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::clear() {
+	heap_.clear(); //Clear underlying array
+}
+
+//Replace contents with the elements of an array, keeping their order if it already is a heap
+template <typename T, typename Storage>
+template <typename Source>
+void MinHeap<T, Storage>::assign(const Source& elements) {
+	heap_.clear();
+	for (int i = 0; i < elements.size(); i++)
+		heap_.pushBack(elements[i]); //Take over elements in their order
+	if (!isHeap())
+		buildHeap(); //Rebuild only if the order is not a heap
+}
+
+//Check if the whole array satisfies the heap property
+template <typename T, typename Storage>
+bool MinHeap<T, Storage>::isHeap() const {
+	for (int i = 1; i < heap_.size(); i++)
+		if (heap_[i] < heap_[(i - 1) / 2])
+			return false; //Child is smaller than its parent
+	return true;
+}
+
+//Restore heap property of the whole array (Floyd)
+template <typename T, typename Storage>
+void MinHeap<T, Storage>::buildHeap() {
+	for (int i = heap_.size() / 2 - 1; i >= 0; i--)
+		heapifyDown(i); //Sift down every internal node, starting from the last one
+}
 
 #endif // !MINHEAP_H
\ No newline at end of file
@@ -0,0 +1,288 @@
+#ifndef MINMAXHEAP_H
+#define MINMAXHEAP_H
+
+#include <utility>
+#include "DynamicArray.h"
+
+//Min-max heap class template
+//Nodes on even levels are not greater than their descendants, nodes on odd levels are not smaller,
+//so the minimum is the root and the maximum is one of its children
+template <typename T>
+class MinMaxHeap {
+public:
+	MinMaxHeap() = default; //Default constructor
+	MinMaxHeap(int capacity); //Constructor with initial capacity
+	~MinMaxHeap() = default; //Destructor
+	void insert(const T& element); //Insert element into the heap
+	void removeMin(); //Remove minimum element from the heap
+	void removeMax(); //Remove maximum element from the heap
+	T extractMin(); //Extract minimum element from the heap
+	T extractMax(); //Extract maximum element from the heap
+	const T& min() const; //Get minimum element (const version)
+	const T& max() const; //Get maximum element (const version)
+	bool empty() const; //Check if the heap is empty
+	int find(const T& element) const; //Find element in the heap
+	void remove(int index); //Remove element at index
+	void replace(int index, const T& element); //Replace element at index
+	const T& get(int index) const; //Get element at index (const version)
+	int size() const; //Get size of the heap
+private:
+	static bool isMinLevel(int index); //Check if index lies on a min level
+	int maxIndex() const; //Get index of maximum element
+	void bubbleUp(int index); //Move element at index up to its place
+	void bubbleUpMin(int index); //Move element up along min levels
+	void bubbleUpMax(int index); //Move element up along max levels
+	void trickleDown(int index); //Move element at index down to its place
+	void trickleDownMin(int index); //Move element down along min levels
+	void trickleDownMax(int index); //Move element down along max levels
+	int extremeDescendant(int index, bool smallest) const; //Get index of the smallest or largest child or grandchild
+	void fix(int index); //Restore heap property after element at index changed
+	DynamicArray<T> heap_; //Dynamic array to store heap elements
+};
+
+//Constructor with initial capacity
+template <typename T>
+MinMaxHeap<T>::MinMaxHeap(int capacity) {
+	if (capacity < 0)
+		throw std::out_of_range("Given capacity is negative"); //Check for negative capacity
+	heap_ = DynamicArray<T>(capacity); //Initialize heap with given capacity
+}
+
+//Insert element into the heap
+template <typename T>
+void MinMaxHeap<T>::insert(const T& element) {
+	heap_.pushBack(element); //Add element to the end
+	bubbleUp(heap_.size() - 1); //Bubble up to maintain heap property
+}
+
+//Remove minimum element from the heap
+template <typename T>
+void MinMaxHeap<T>::removeMin() {
+	if (heap_.empty())
+		throw std::out_of_range("Heap is empty"); //Check if heap is empty
+	remove(0); //Minimum is the root
+}
+
+//Remove maximum element from the heap
+template <typename T>
+void MinMaxHeap<T>::removeMax() {
+	if (heap_.empty())
+		throw std::out_of_range("Heap is empty"); //Check if heap is empty
+	remove(maxIndex()); //Maximum is the root or one of its children
+}
+
+//Extract minimum element from the heap
+template <typename T>
+T MinMaxHeap<T>::extractMin() {
+	T minimal = min(); //Get minimum element
+	removeMin(); //Remove minimum element
+	return minimal; //Return minimum element
+}
+
+//Extract maximum element from the heap
+template <typename T>
+T MinMaxHeap<T>::extractMax() {
+	T maximal = max(); //Get maximum element
+	removeMax(); //Remove maximum element
+	return maximal; //Return maximum element
+}
+
+//Get minimum element (const version)
+template <typename T>
+const T& MinMaxHeap<T>::min() const {
+	if (heap_.empty())
+		throw std::out_of_range("Heap is empty"); //Check if heap is empty
+	return heap_.front(); //Return minimum element
+}
+
+//Get maximum element (const version)
+template <typename T>
+const T& MinMaxHeap<T>::max() const {
+	if (heap_.empty())
+		throw std::out_of_range("Heap is empty"); //Check if heap is empty
+	return heap_[maxIndex()]; //Return maximum element
+}
+
+//Check if the heap is empty
+template <typename T>
+bool MinMaxHeap<T>::empty() const {
+	return heap_.empty(); //Check if heap is empty
+}
+
+//Find element in the heap
+template <typename T>
+int MinMaxHeap<T>::find(const T& element) const {
+	return heap_.find(element); //Find element in the heap
+}
+
+//Remove element at index
+template <typename T>
+void MinMaxHeap<T>::remove(int index) {
+	if (index < 0 || index >= heap_.size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	heap_[index] = heap_[heap_.size() - 1]; //Move last element into the gap
+	heap_.popBack(); //Remove last element
+	if (index < heap_.size())
+		fix(index); //Restore heap property
+}
+
+//Replace element at index
+template <typename T>
+void MinMaxHeap<T>::replace(int index, const T& element) {
+	if (index < 0 || index >= heap_.size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	heap_[index] = element; //Replace element at index
+	fix(index); //Restore heap property
+}
+
+//Get element at index (const version)
+template <typename T>
+const T& MinMaxHeap<T>::get(int index) const {
+	if (index < 0 || index >= heap_.size())
+		throw std::out_of_range("Index out of range"); //Check for valid index
+	return heap_[index]; //Return element at index
+}
+
+//Get size of the heap
+template <typename T>
+int MinMaxHeap<T>::size() const {
+	return heap_.size(); //Get size of the heap
+}
+
+//Check if index lies on a min level
+template <typename T>
+bool MinMaxHeap<T>::isMinLevel(int index) {
+	int level = 0; //Depth of the index
+	for (int i = index + 1; i > 1; i >>= 1)
+		level++;
+	return level % 2 == 0; //Even levels are min levels
+}
+
+//Get index of maximum element
+template <typename T>
+int MinMaxHeap<T>::maxIndex() const {
+	if (heap_.size() == 1)
+		return 0; //Root is the only element
+	if (heap_.size() == 2 || heap_[1] > heap_[2])
+		return 1; //Left child of the root
+	return 2; //Right child of the root
+}
+
+//Move element at index up to its place
+template <typename T>
+void MinMaxHeap<T>::bubbleUp(int index) {
+	if (index == 0)
+		return;
+	int parent = (index - 1) / 2; //Get parent index
+	if (isMinLevel(index)) {
+		if (heap_[index] > heap_[parent]) {
+			std::swap(heap_[index], heap_[parent]); //Element belongs to the max levels
+			bubbleUpMax(parent);
+		}
+		else
+			bubbleUpMin(index);
+	}
+	else {
+		if (heap_[index] < heap_[parent]) {
+			std::swap(heap_[index], heap_[parent]); //Element belongs to the min levels
+			bubbleUpMin(parent);
+		}
+		else
+			bubbleUpMax(index);
+	}
+}
+
+//Move element up along min levels
+template <typename T>
+void MinMaxHeap<T>::bubbleUpMin(int index) {
+	while (index > 2) {
+		int grandparent = ((index - 1) / 2 - 1) / 2; //Get grandparent index
+		if (heap_[index] < heap_[grandparent]) {
+			std::swap(heap_[index], heap_[grandparent]); //Swap with grandparent if current element is smaller
+			index = grandparent;
+		}
+		else
+			break;
+	}
+}
+
+//Move element up along max levels
+template <typename T>
+void MinMaxHeap<T>::bubbleUpMax(int index) {
+	while (index > 2) {
+		int grandparent = ((index - 1) / 2 - 1) / 2; //Get grandparent index
+		if (heap_[index] > heap_[grandparent]) {
+			std::swap(heap_[index], heap_[grandparent]); //Swap with grandparent if current element is larger
+			index = grandparent;
+		}
+		else
+			break;
+	}
+}
+
+//Move element at index down to its place
+template <typename T>
+void MinMaxHeap<T>::trickleDown(int index) {
+	if (isMinLevel(index))
+		trickleDownMin(index);
+	else
+		trickleDownMax(index);
+}
+
+//Move element down along min levels
+template <typename T>
+void MinMaxHeap<T>::trickleDownMin(int index) {
+	while (2 * index + 1 < heap_.size()) {
+		int m = extremeDescendant(index, true); //Smallest child or grandchild
+		if (!(heap_[m] < heap_[index]))
+			break;
+		std::swap(heap_[m], heap_[index]); //Swap with smallest descendant
+		if (m <= 2 * index + 2)
+			break; //Child sits on a max level, nothing below it to fix
+		int parent = (m - 1) / 2; //Parent of the grandchild lies on a max level
+		if (heap_[m] > heap_[parent])
+			std::swap(heap_[m], heap_[parent]);
+		index = m;
+	}
+}
+
+//Move element down along max levels
+template <typename T>
+void MinMaxHeap<T>::trickleDownMax(int index) {
+	while (2 * index + 1 < heap_.size()) {
+		int m = extremeDescendant(index, false); //Largest child or grandchild
+		if (!(heap_[m] > heap_[index]))
+			break;
+		std::swap(heap_[m], heap_[index]); //Swap with largest descendant
+		if (m <= 2 * index + 2)
+			break; //Child sits on a min level, nothing below it to fix
+		int parent = (m - 1) / 2; //Parent of the grandchild lies on a min level
+		if (heap_[m] < heap_[parent])
+			std::swap(heap_[m], heap_[parent]);
+		index = m;
+	}
+}
+
+//Get index of the smallest or largest child or grandchild
+template <typename T>
+int MinMaxHeap<T>::extremeDescendant(int index, bool smallest) const {
+	int best = 2 * index + 1; //Start with the left child
+	int candidates[] = {2 * index + 2, 4 * index + 3, 4 * index + 4, 4 * index + 5, 4 * index + 6};
+	for (int candidate : candidates) {
+		if (candidate >= heap_.size())
+			break; //Descendants are stored contiguously, the rest is missing too
+		if (smallest ? heap_[candidate] < heap_[best] : heap_[candidate] > heap_[best])
+			best = candidate;
+	}
+	return best;
+}
+
+//Restore heap property after element at index changed
+//If the element goes up, whatever lands on index came from an ancestor and may still have to go down
+template <typename T>
+void MinMaxHeap<T>::fix(int index) {
+	bubbleUp(index);
+	trickleDown(index);
+}
+
+#endif // !MINMAXHEAP_H
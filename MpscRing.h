@@ -0,0 +1,115 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "ConcurrentSync.h"
+
+//Bounded lock-free ring with many producers and one consumer after Vyukov
+//Every cell carries a sequence number telling whose turn it is: a producer claims a cell with one CAS on the tail
+//and publishes it by bumping the sequence, the consumer frees it by bumping the sequence again by the capacity
+//With one producer per ring the CAS never fails, so the ring then works as a plain SPSC ring
+template <typename T>
+class MpscRing {
+public:
+	explicit MpscRing(int capacity); //Constructor, capacity is rounded up to a power of two
+	MpscRing(const MpscRing& other) = delete; //Cells are shared by reference between threads
+	MpscRing& operator=(const MpscRing& other) = delete; //Cells are shared by reference between threads
+	bool tryPush(T&& element); //Add element from any thread, returns false and leaves element intact if the ring is full
+	bool tryPop(T& element); //Remove the oldest element, consumer thread only
+	template <typename Consume>
+	int drain(Consume&& consume); //Pass every published element to consume, consumer thread only
+	bool empty() const; //Check if nothing is published, consumer thread only
+	int capacity() const; //Get number of cells
+private:
+	struct Cell {
+		std::atomic<uint64_t> sequence; //Equals the position when free, the position plus one when published
+		T element; //Stored element
+	};
+	std::unique_ptr<Cell[]> cells_; //Ring storage
+	uint64_t mask_; //Capacity minus one
+	alignas(CACHE_LINE) std::atomic<uint64_t> tail_; //Next position claimed by a producer
+	alignas(CACHE_LINE) uint64_t head_; //Next position read by the consumer
+};
+
+//Constructor, capacity is rounded up to a power of two
+template <typename T>
+MpscRing<T>::MpscRing(int capacity) : tail_(0), head_(0) {
+	if (capacity < 1)
+		throw std::invalid_argument("Ring capacity must be positive"); //Check for empty ring
+	uint64_t cells = 1;
+	while (cells < static_cast<uint64_t>(capacity))
+		cells <<= 1;
+	mask_ = cells - 1;
+	cells_ = std::make_unique<Cell[]>(cells);
+	for (uint64_t i = 0; i < cells; i++)
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+//Add element from any thread, returns false and leaves element intact if the ring is full
+template <typename T>
+bool MpscRing<T>::tryPush(T&& element) {
+	uint64_t position = tail_.load(std::memory_order_relaxed);
+	while (true) {
+		Cell& cell = cells_[position & mask_];
+		uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+		int64_t turn = static_cast<int64_t>(sequence - position);
+		if (turn == 0) {
+			if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				cell.element = std::move(element);
+				cell.sequence.store(position + 1, std::memory_order_release); //Publish to the consumer
+				return true;
+			}
+		} else if (turn < 0) {
+			return false; //Consumer has not freed the cell from the previous round yet
+		} else {
+			position = tail_.load(std::memory_order_relaxed); //Another producer took the cell
+		}
+	}
+}
+
+//Remove the oldest element, consumer thread only
+template <typename T>
+bool MpscRing<T>::tryPop(T& element) {
+	Cell& cell = cells_[head_ & mask_];
+	if (cell.sequence.load(std::memory_order_acquire) != head_ + 1)
+		return false; //Not published yet
+	element = std::move(cell.element);
+	cell.sequence.store(head_ + mask_ + 1, std::memory_order_release); //Hand the cell to the next round of producers
+	head_++;
+	return true;
+}
+
+//Pass every published element to consume, consumer thread only
+//Stops at the first cell that is claimed but not yet published, its producer finishes it for the next drain
+template <typename T>
+template <typename Consume>
+int MpscRing<T>::drain(Consume&& consume) {
+	int count = 0;
+	while (true) {
+		Cell& cell = cells_[head_ & mask_];
+		if (cell.sequence.load(std::memory_order_acquire) != head_ + 1)
+			return count;
+		consume(std::move(cell.element));
+		cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+		head_++;
+		count++;
+	}
+}
+
+//Check if nothing is published, consumer thread only
+template <typename T>
+bool MpscRing<T>::empty() const {
+	return cells_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+}
+
+//Get number of cells
+template <typename T>
+int MpscRing<T>::capacity() const {
+	return static_cast<int>(mask_ + 1);
+}
+
+#endif // !MPSC_RING_H
@@ -0,0 +1,121 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <new>
+#include <utility>
+
+//Pool allocator for nodes of linked structures
+//Nodes are carved out of blocks and recycled through a free list, so node-based heaps avoid a heap allocation per element
+//The pool does not track live nodes – its owner has to release them before the pool is destroyed
+template <typename NodeT, int BlockSize = 256>
+class NodePool {
+public:
+	NodePool(); //Default constructor
+	~NodePool(); //Destructor
+	NodePool(const NodePool& other) = delete; //Pools cannot be copied
+	NodePool& operator=(const NodePool& other) = delete; //Pools cannot be copied
+	template <typename... Args>
+	NodeT* acquire(Args&&... args); //Construct a node in a free slot
+	void release(NodeT* node); //Destroy node and return its slot to the pool
+	void absorb(NodePool& other); //Take over all blocks of other pool
+private:
+	union Slot {
+		Slot* next; //Next free slot
+		alignas(NodeT) unsigned char storage[sizeof(NodeT)]; //Storage of a node
+	};
+	struct Block {
+		Block* next; //Next block in the pool
+		Slot slots[BlockSize]; //Slots of the block
+	};
+	void pushFree(Slot* slot); //Add slot to the free list
+	Block* blocks_; //Newest block first
+	Block* lastBlock_; //Oldest block, used for splicing pools together
+	Slot* free_; //Head of the free list
+	Slot* freeTail_; //Tail of the free list
+	int used_; //Number of slots handed out from the newest block
+};
+
+//Default constructor
+template <typename NodeT, int BlockSize>
+NodePool<NodeT, BlockSize>::NodePool() : blocks_(nullptr), lastBlock_(nullptr), free_(nullptr), freeTail_(nullptr), used_(BlockSize) {}
+
+//Destructor
+template <typename NodeT, int BlockSize>
+NodePool<NodeT, BlockSize>::~NodePool() {
+	while (blocks_) {
+		Block* next = blocks_->next;
+		delete blocks_; //Deallocate block
+		blocks_ = next;
+	}
+}
+
+//Construct a node in a free slot
+template <typename NodeT, int BlockSize>
+template <typename... Args>
+NodeT* NodePool<NodeT, BlockSize>::acquire(Args&&... args) {
+	Slot* slot;
+	if (free_) {
+		slot = free_; //Reuse a released slot
+		free_ = free_->next;
+		if (!free_)
+			freeTail_ = nullptr;
+	}
+	else {
+		if (used_ == BlockSize) {
+			Block* block = new Block; //Allocate a new block
+			block->next = blocks_;
+			blocks_ = block;
+			if (!lastBlock_)
+				lastBlock_ = block;
+			used_ = 0;
+		}
+		slot = &blocks_->slots[used_++]; //Take the next untouched slot
+	}
+	return new (slot->storage) NodeT(std::forward<Args>(args)...);
+}
+
+//Destroy node and return its slot to the pool
+template <typename NodeT, int BlockSize>
+void NodePool<NodeT, BlockSize>::release(NodeT* node) {
+	node->~NodeT(); //Destroy node
+	pushFree(reinterpret_cast<Slot*>(node));
+}
+
+//Take over all blocks of other pool, nodes allocated from other stay valid and can be released here
+template <typename NodeT, int BlockSize>
+void NodePool<NodeT, BlockSize>::absorb(NodePool& other) {
+	if (this == &other || !other.blocks_)
+		return;
+	for (int i = other.used_; i < BlockSize; i++)
+		pushFree(&other.blocks_->slots[i]); //Untouched slots of the newest block become free slots
+	if (other.free_) {
+		if (freeTail_)
+			freeTail_->next = other.free_; //Append free list of other pool
+		else
+			free_ = other.free_;
+		freeTail_ = other.freeTail_;
+	}
+	if (lastBlock_)
+		lastBlock_->next = other.blocks_; //Append blocks of other pool
+	else {
+		blocks_ = other.blocks_;
+		used_ = BlockSize;
+	}
+	lastBlock_ = other.lastBlock_;
+	other.blocks_ = nullptr;
+	other.lastBlock_ = nullptr;
+	other.free_ = nullptr;
+	other.freeTail_ = nullptr;
+	other.used_ = BlockSize;
+}
+
+//Add slot to the free list
+template <typename NodeT, int BlockSize>
+void NodePool<NodeT, BlockSize>::pushFree(Slot* slot) {
+	slot->next = free_;
+	free_ = slot;
+	if (!freeTail_)
+		freeTail_ = slot;
+}
+
+#endif // !NODE_POOL_H
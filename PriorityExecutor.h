@@ -0,0 +1,212 @@
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "PriorityQueueMinHeap.h"
+#include "BlockingPriorityQueue.h"
+
+#ifndef SD_P2_PRIORITYEXECUTOR_H
+#define SD_P2_PRIORITYEXECUTOR_H
+
+//Counts the tasks of an executor that have not finished and keeps the first exception one of them threw
+class TaskTracker {
+public:
+    void started() {
+        std::lock_guard<std::mutex> guard(mutex);
+        pending++;
+    }
+
+    //Runs while the frame of the task is destroyed, so it must not touch the task afterwards
+    void finished(std::exception_ptr thrown) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (thrown && !error) error = thrown;
+        pending--;
+        //Notified under the lock, so a waiter cannot return and destroy the tracker before this call is done
+        if (pending == 0) allDone.notify_all();
+    }
+
+    void waitAll() {
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone.wait(lock, [this] { return pending == 0; });
+    }
+
+    int running() {
+        std::lock_guard<std::mutex> guard(mutex);
+        return pending;
+    }
+
+    //Rethrows the first exception of a task, once
+    void rethrow() {
+        std::exception_ptr thrown;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            std::swap(thrown, error);
+        }
+        if (thrown) std::rethrow_exception(thrown);
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable allDone;
+    int pending = 0;
+    std::exception_ptr error;
+};
+
+//Coroutine started by PriorityExecutor::spawn and never awaited by anyone
+//It stays suspended until spawned and its frame is destroyed as soon as it returns
+class PriorityTask {
+public:
+    struct promise_type {
+        TaskTracker* tracker = nullptr;
+        std::exception_ptr thrown;
+
+        PriorityTask get_return_object() {
+            return PriorityTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            thrown = std::current_exception();
+        }
+
+        ~promise_type() {
+            if (tracker) tracker->finished(thrown);
+        }
+    };
+
+    PriorityTask(PriorityTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    PriorityTask(const PriorityTask&) = delete;
+    PriorityTask& operator=(const PriorityTask&) = delete;
+
+    //A task that was never spawned is destroyed without running
+    ~PriorityTask() {
+        if (handle) handle.destroy();
+    }
+
+    //Hands the coroutine over to the caller, the task no longer owns it
+    std::coroutine_handle<promise_type> release() {
+        return std::exchange(handle, nullptr);
+    }
+
+private:
+    explicit PriorityTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+//Runs coroutines in priority order, smaller priorities first
+//The ready queue holds the handles of suspended coroutines that may continue, in any backend of this repo
+//With no threads the caller drives it through run, otherwise the worker threads sleep on the ready queue until
+//a coroutine becomes ready, so idle workers cost nothing
+//Coroutines still suspended when the executor is destroyed are never resumed and their frames are leaked
+template <typename Backend = PriorityQueueMinHeap<std::coroutine_handle<>>>
+class PriorityExecutor {
+private:
+    BlockingPriorityQueue<Backend> ready;
+    TaskTracker tracker;
+    std::vector<std::thread> workers;
+
+    void work() {
+        std::coroutine_handle<> handle;
+        while (ready.waitDequeue(handle)) {
+            handle.resume();
+        }
+    }
+
+public:
+    //Awaiting it suspends the coroutine and queues it with priority, so more urgent ones run first
+    class ScheduleAwaiter {
+    public:
+        ScheduleAwaiter(PriorityExecutor& executor, int priority) : executor(executor), priority(priority) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            executor.post(handle, priority);
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        PriorityExecutor& executor;
+        int priority;
+    };
+
+    //threads worker threads, or none to run everything in the thread that calls run
+    explicit PriorityExecutor(int threads = 0) {
+        for (int i = 0; i < threads; i++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    //Workers finish the coroutines that are ready, including those they make ready meanwhile, and then stop
+    ~PriorityExecutor() {
+        ready.close();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    PriorityExecutor(const PriorityExecutor&) = delete;
+    PriorityExecutor& operator=(const PriorityExecutor&) = delete;
+
+    int threadCount() const {
+        return static_cast<int>(workers.size());
+    }
+
+    //Queues a suspended coroutine to be resumed with priority
+    void post(std::coroutine_handle<> handle, int priority) {
+        ready.enqueue(handle, priority);
+    }
+
+    //co_await executor.schedule(priority) moves the rest of the coroutine behind more urgent work
+    ScheduleAwaiter schedule(int priority) {
+        return ScheduleAwaiter(*this, priority);
+    }
+
+    //Starts task with priority, the executor owns it from now on
+    void spawn(PriorityTask task, int priority) {
+        std::coroutine_handle<PriorityTask::promise_type> handle = task.release();
+        handle.promise().tracker = &tracker;
+        tracker.started();
+        post(handle, priority);
+    }
+
+    //Number of spawned tasks that have not returned yet
+    int runningTasks() {
+        return tracker.running();
+    }
+
+    //Resumes ready coroutines in the calling thread until none is ready
+    //Rethrows the first exception a task threw
+    void run() {
+        std::coroutine_handle<> handle;
+        while (ready.tryDequeue(handle)) {
+            handle.resume();
+        }
+        tracker.rethrow();
+    }
+
+    //Blocks until every spawned task has returned, for executors with worker threads
+    //Rethrows the first exception a task threw
+    void waitAll() {
+        tracker.waitAll();
+        tracker.rethrow();
+    }
+};
+
+#endif //SD_P2_PRIORITYEXECUTOR_H
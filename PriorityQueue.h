@@ -1,16 +1,70 @@
 #ifndef SD_P2_PRIORITYQUEUE_H
 #define SD_P2_PRIORITYQUEUE_H
 
+#include <functional>
+#include <string>
+#include <vector>
+#include "Snapshot.h"
+
 template <typename T>
 class PriorityQueue {
 public:
+    using value_type = T;
+
     virtual void enqueue(T element, int priority) = 0;
     virtual T dequeue() = 0;
     virtual T peek() const = 0;
+    virtual int peekPriority() const = 0;
     virtual int getSize() const = 0;
     virtual void modifyPriority(T element, int newPriority) = 0;
     virtual bool isEmpty() const = 0;
+
+    //Moves all elements of other into this queue and leaves other empty
+    //Backends override it with a native meld when other is of the same type
+    virtual void meld(PriorityQueue<T>&& other) {
+        if (&other == this) return;
+        while (!other.isEmpty()) {
+            int priority = other.peekPriority();
+            enqueue(other.dequeue(), priority);
+        }
+    }
+
+    //Adds a batch of elements, backends that can build themselves from a batch do it faster than single enqueues
+    //The entries may be moved from
+    void enqueueBulk(std::vector<SnapshotEntry<T>>& entries) {
+        loadEntries(entries);
+    }
+
+    //Calls visit for every element and its priority, in no particular order
+    virtual void forEachEntry(const std::function<void(const T&, int)>& visit) const = 0;
+
+    //Writes every element with its priority to a snapshot file
+    virtual void saveSnapshot(const std::string& path) const {
+        SnapshotWriter<T> writer(path, SnapshotLayout::Stream);
+        forEachEntry([&writer](const T& element, int priority) {
+            writer.write(element, priority);
+        });
+        writer.close();
+    }
+
+    //Adds every element of a snapshot file to the queue
+    virtual void loadSnapshot(const std::string& path) {
+        SnapshotReader<T> reader(path);
+        std::vector<SnapshotEntry<T>> entries;
+        reader.readAll(entries);
+        loadEntries(entries);
+    }
+
     virtual ~PriorityQueue() = default;
+
+protected:
+    //Adds a batch of elements read from a snapshot
+    //Backends that can build themselves from a batch faster than by single enqueues override it
+    virtual void loadEntries(std::vector<SnapshotEntry<T>>& entries) {
+        for (SnapshotEntry<T>& entry : entries) {
+            enqueue(entry.element, entry.priority);
+        }
+    }
 };
 
 #endif //SD_P2_PRIORITYQUEUE_H
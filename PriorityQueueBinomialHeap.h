@@ -0,0 +1,255 @@
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "NodePool.h"
+
+#ifndef SD_P2_PRIORITYQUEUEBINOMIALHEAP_H
+#define SD_P2_PRIORITYQUEUEBINOMIALHEAP_H
+
+template <typename T>
+struct BinomialNode {
+    T element;
+    int priority;
+    int degree;
+
+    BinomialNode* parent;
+    BinomialNode* child; //Child with the highest degree
+    BinomialNode* sibling; //Next root, or next child with a lower degree
+
+    BinomialNode(T element, int priority)
+            : element(element), priority(priority), degree(0), parent(nullptr), child(nullptr), sibling(nullptr) {}
+};
+
+//Binomial heap – a list of binomial trees ordered by degree, melded like binary addition in O(log n)
+//The minimal root is cached so peek is O(1)
+template <typename T>
+class PriorityQueueBinomialHeap : public PriorityQueue<T> {
+private:
+    NodePool<BinomialNode<T>> pool;
+    BinomialNode<T>* head; //Root with the lowest degree
+    BinomialNode<T>* minNode;
+    int n;
+
+    //Makes the root nodeCh the leftmost child of the root nodeP with the same degree
+    static void link(BinomialNode<T>* nodeCh, BinomialNode<T>* nodeP) {
+        nodeCh->parent = nodeP;
+        nodeCh->sibling = nodeP->child;
+        nodeP->child = nodeCh;
+        nodeP->degree++;
+    }
+
+    //Merges two root lists into one ordered by degree
+    static BinomialNode<T>* mergeRootLists(BinomialNode<T>* first, BinomialNode<T>* second) {
+        BinomialNode<T>* merged = nullptr;
+        BinomialNode<T>** tail = &merged;
+        while (first && second) {
+            if (first->degree <= second->degree) {
+                *tail = first;
+                first = first->sibling;
+            } else {
+                *tail = second;
+                second = second->sibling;
+            }
+            tail = &(*tail)->sibling;
+        }
+        *tail = first ? first : second;
+        return merged;
+    }
+
+    //Merges the root lists and links trees of equal degree, carrying like in binary addition
+    static BinomialNode<T>* unite(BinomialNode<T>* first, BinomialNode<T>* second) {
+        BinomialNode<T>* merged = mergeRootLists(first, second);
+        if (!merged) return nullptr;
+
+        BinomialNode<T>* prev = nullptr;
+        BinomialNode<T>* curr = merged;
+        BinomialNode<T>* next = curr->sibling;
+        while (next) {
+            if (curr->degree != next->degree || (next->sibling && next->sibling->degree == curr->degree)) {
+                prev = curr;
+                curr = next;
+            } else if (curr->priority <= next->priority) {
+                curr->sibling = next->sibling;
+                link(next, curr);
+            } else {
+                if (prev) prev->sibling = next;
+                else merged = next;
+                link(curr, next);
+                curr = next;
+            }
+            next = curr->sibling;
+        }
+        return merged;
+    }
+
+    void updateMin() {
+        minNode = head;
+        for (BinomialNode<T>* root = head; root; root = root->sibling) {
+            if (root->priority < minNode->priority) minNode = root;
+        }
+    }
+
+    //Removes the given root from the root list and melds its children back
+    void removeRoot(BinomialNode<T>* root) {
+        BinomialNode<T>* prev = nullptr;
+        for (BinomialNode<T>* curr = head; curr != root; curr = curr->sibling) {
+            prev = curr;
+        }
+        if (prev) prev->sibling = root->sibling;
+        else head = root->sibling;
+
+        //Children are ordered by decreasing degree, the root list needs them the other way round
+        BinomialNode<T>* reversed = nullptr;
+        BinomialNode<T>* child = root->child;
+        while (child) {
+            BinomialNode<T>* next = child->sibling;
+            child->sibling = reversed;
+            child->parent = nullptr;
+            reversed = child;
+            child = next;
+        }
+        head = unite(head, reversed);
+        pool.release(root);
+        n--;
+        updateMin();
+    }
+
+    //Moves the content of the node upwards while it beats its parent, returns where it ended
+    static BinomialNode<T>* bubbleUp(BinomialNode<T>* node, bool toRoot) {
+        while (node->parent && (toRoot || node->priority < node->parent->priority)) {
+            std::swap(node->element, node->parent->element);
+            std::swap(node->priority, node->parent->priority);
+            node = node->parent;
+        }
+        return node;
+    }
+
+    BinomialNode<T>* findNode(const T& element) const {
+        std::vector<BinomialNode<T>*> stack;
+        for (BinomialNode<T>* root = head; root; root = root->sibling) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            BinomialNode<T>* node = stack.back();
+            stack.pop_back();
+            if (node->element == element) return node;
+            for (BinomialNode<T>* child = node->child; child; child = child->sibling) {
+                stack.push_back(child);
+            }
+        }
+        return nullptr;
+    }
+
+    void releaseAll() {
+        std::vector<BinomialNode<T>*> stack;
+        for (BinomialNode<T>* root = head; root; root = root->sibling) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            BinomialNode<T>* node = stack.back();
+            stack.pop_back();
+            for (BinomialNode<T>* child = node->child; child; child = child->sibling) {
+                stack.push_back(child);
+            }
+            pool.release(node);
+        }
+        head = nullptr;
+        minNode = nullptr;
+        n = 0;
+    }
+
+public:
+    PriorityQueueBinomialHeap() : head(nullptr), minNode(nullptr), n(0) {}
+
+    ~PriorityQueueBinomialHeap() {
+        releaseAll();
+    }
+
+    //Moves all elements of other into this heap in O(log n), leaving other empty
+    void meld(PriorityQueueBinomialHeap& other) {
+        if (this == &other) return;
+        pool.absorb(other.pool);
+        head = unite(head, other.head);
+        n += other.n;
+        other.head = nullptr;
+        other.minNode = nullptr;
+        other.n = 0;
+        updateMin();
+    }
+
+    void meld(PriorityQueue<T>&& other) override {
+        auto* same = dynamic_cast<PriorityQueueBinomialHeap<T>*>(&other);
+        if (!same) {
+            PriorityQueue<T>::meld(std::move(other));
+            return;
+        }
+        meld(*same);
+    }
+
+    void enqueue(T element, int priority) override {
+        BinomialNode<T>* node = pool.acquire(element, priority);
+        head = unite(head, node);
+        n++;
+        updateMin();
+    }
+
+    T dequeue() override {
+        if (!minNode) throw std::runtime_error("Queue is empty");
+        T element = minNode->element;
+        removeRoot(minNode);
+        return element;
+    }
+
+    T peek() const override {
+        if (!minNode) throw std::runtime_error("Queue is empty");
+        return minNode->element;
+    }
+
+    int peekPriority() const override {
+        if (!minNode) throw std::runtime_error("Queue is empty");
+        return minNode->priority;
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    //Decreasing bubbles the element up, increasing removes it and inserts it again
+    void modifyPriority(T element, int newPriority) override {
+        BinomialNode<T>* node = findNode(element);
+        if (!node) return;
+
+        if (newPriority <= node->priority) {
+            node->priority = newPriority;
+            node = bubbleUp(node, false);
+            if (newPriority < minNode->priority) minNode = node;
+            return;
+        }
+
+        T moved = node->element;
+        removeRoot(bubbleUp(node, true));
+        enqueue(moved, newPriority);
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        std::vector<BinomialNode<T>*> stack;
+        for (BinomialNode<T>* root = head; root; root = root->sibling) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            BinomialNode<T>* node = stack.back();
+            stack.pop_back();
+            visit(node->element, node->priority);
+            for (BinomialNode<T>* child = node->child; child; child = child->sibling) {
+                stack.push_back(child);
+            }
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEBINOMIALHEAP_H
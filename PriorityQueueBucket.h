@@ -0,0 +1,177 @@
+#include <stdexcept>
+#include <vector>
+#include "PriorityQueue.h"
+#include "HierarchicalBitmap.h"
+
+#ifndef SD_P2_PRIORITYQUEUEBUCKET_H
+#define SD_P2_PRIORITYQUEUEBUCKET_H
+
+//Entry of a bucket – links to its neighbours are indices into the entry pool
+template <typename T>
+struct BucketEntry {
+    T element;
+    int priority;
+    int prev;
+    int next;
+    bool active;
+
+    BucketEntry() : element(T()), priority(0), prev(-1), next(-1), active(false) {}
+};
+
+//Bucket queue for integer priorities in [0, maxPriority]
+//Every priority owns a FIFO bucket and a bitmap hierarchy tracks the non-empty buckets
+template <typename T>
+class PriorityQueueBucket : public PriorityQueue<T> {
+public:
+    //Refers to the entry holding an element, valid until the element leaves the queue
+    struct Handle {
+        int index;
+    };
+
+private:
+    std::vector<BucketEntry<T>> entries;
+    std::vector<int> freeEntries;
+    std::vector<int> bucketHead;
+    std::vector<int> bucketTail;
+    HierarchicalBitmap nonEmpty;
+    int maxPriority;
+    int lowestBucket; //No bucket below this index holds an element
+    int n;
+
+    void checkPriority(int priority) const {
+        if (priority < 0 || priority > maxPriority) {
+            throw std::out_of_range("Priority out of range");
+        }
+    }
+
+    //Appends the entry to the tail of its priority's bucket
+    void link(int index) {
+        BucketEntry<T>& entry = entries[index];
+        int bucket = entry.priority;
+        entry.prev = bucketTail[bucket];
+        entry.next = -1;
+        if (bucketTail[bucket] == -1) {
+            bucketHead[bucket] = index;
+            nonEmpty.set(bucket);
+        } else {
+            entries[bucketTail[bucket]].next = index;
+        }
+        bucketTail[bucket] = index;
+        if (bucket < lowestBucket) {
+            lowestBucket = bucket;
+        }
+    }
+
+    //Detaches the entry from its bucket
+    void unlink(int index) {
+        BucketEntry<T>& entry = entries[index];
+        int bucket = entry.priority;
+        if (entry.prev == -1) bucketHead[bucket] = entry.next;
+        else entries[entry.prev].next = entry.next;
+        if (entry.next == -1) bucketTail[bucket] = entry.prev;
+        else entries[entry.next].prev = entry.prev;
+        if (bucketHead[bucket] == -1) {
+            nonEmpty.reset(bucket);
+        }
+    }
+
+    //Finds the first non-empty bucket, starting from the remembered lower bound
+    int minBucket() const {
+        return nonEmpty.findNext(lowestBucket);
+    }
+
+    void release(int index) {
+        entries[index].active = false;
+        entries[index].element = T();
+        freeEntries.push_back(index);
+        n--;
+    }
+
+public:
+    explicit PriorityQueueBucket(int maxPriority = 1000000)
+            : bucketHead(maxPriority + 1, -1), bucketTail(maxPriority + 1, -1),
+              nonEmpty(maxPriority + 1), maxPriority(maxPriority), lowestBucket(maxPriority + 1), n(0) {
+        if (maxPriority < 0) throw std::out_of_range("Maximal priority cannot be negative");
+    }
+
+    //Inserts the element and returns a handle usable with modifyPriority
+    Handle push(T element, int priority) {
+        checkPriority(priority);
+        int index;
+        if (!freeEntries.empty()) {
+            index = freeEntries.back();
+            freeEntries.pop_back();
+        } else {
+            index = static_cast<int>(entries.size());
+            entries.emplace_back();
+        }
+        BucketEntry<T>& entry = entries[index];
+        entry.element = element;
+        entry.priority = priority;
+        entry.active = true;
+        link(index);
+        n++;
+        return Handle{index};
+    }
+
+    void enqueue(T element, int priority) override {
+        push(element, priority);
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        lowestBucket = minBucket();
+        int index = bucketHead[lowestBucket];
+        T element = entries[index].element;
+        unlink(index);
+        release(index);
+        return element;
+    }
+
+    T peek() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return entries[bucketHead[minBucket()]].element;
+    }
+
+    int peekPriority() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return minBucket();
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    //Moves the entry behind the handle to the tail of the new priority's bucket in O(1)
+    void modifyPriority(Handle handle, int newPriority) {
+        checkPriority(newPriority);
+        int index = handle.index;
+        if (index < 0 || index >= static_cast<int>(entries.size()) || !entries[index].active) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        unlink(index);
+        entries[index].priority = newPriority;
+        link(index);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        for (int i = 0; i < static_cast<int>(entries.size()); i++) {
+            if (entries[i].active && entries[i].element == element) {
+                modifyPriority(Handle{i}, newPriority);
+                return;
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (const BucketEntry<T>& entry : entries) {
+            if (entry.active) visit(entry.element, entry.priority);
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEBUCKET_H
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "PriorityQueue.h"
+
+#ifndef SD_P2_PRIORITYQUEUECALENDAR_H
+#define SD_P2_PRIORITYQUEUECALENDAR_H
+
+template <typename T>
+struct CalendarNode {
+    T element;
+    int priority;
+    CalendarNode* next;
+
+    CalendarNode(T element, int priority) : element(element), priority(priority), next(nullptr) {}
+};
+
+//Calendar queue (Brown, 1988) – priorities are hashed into "days" of a fixed width, every day keeps a sorted list
+//and dequeue walks the calendar one day at a time, so hold-model workloads run in O(1) expected time
+//The number of days follows the size of the queue and the day width is resampled on every resize
+template <typename T>
+class PriorityQueueCalendar : public PriorityQueue<T> {
+private:
+    static constexpr int MIN_BUCKETS = 2;
+    static constexpr int SAMPLE_SIZE = 25;
+
+    std::vector<CalendarNode<T>*> buckets;
+    std::vector<CalendarNode<T>*> tails; //Last node of every bucket, events arriving in order are appended in O(1)
+    int64_t width; //Range of priorities covered by one bucket
+    int64_t lastPriority; //Priority of the last dequeued element
+    int lastBucket; //Bucket the calendar is currently in
+    int64_t bucketTop; //Upper bound of priorities belonging to the current year of lastBucket
+    int n;
+
+    int bucketOf(int64_t priority) const {
+        int64_t day = priority >= 0 ? priority / width : -((-priority + width - 1) / width);
+        int64_t count = static_cast<int64_t>(buckets.size());
+        return static_cast<int>(((day % count) + count) % count);
+    }
+
+    //Moves the calendar to the day of the given priority
+    void moveTo(int64_t priority) {
+        lastPriority = priority;
+        lastBucket = bucketOf(priority);
+        int64_t day = priority >= 0 ? priority / width : -((-priority + width - 1) / width);
+        bucketTop = (day + 1) * width;
+    }
+
+    //Inserts the node into its bucket after all nodes with equal priority
+    void insertNode(CalendarNode<T>* node) {
+        int bucket = bucketOf(node->priority);
+        node->next = nullptr;
+        if (!tails[bucket]) {
+            buckets[bucket] = node;
+            tails[bucket] = node;
+            return;
+        }
+        if (tails[bucket]->priority <= node->priority) {
+            tails[bucket]->next = node;
+            tails[bucket] = node;
+            return;
+        }
+        CalendarNode<T>** link = &buckets[bucket];
+        while ((*link)->priority <= node->priority) {
+            link = &(*link)->next;
+        }
+        node->next = *link;
+        *link = node;
+    }
+
+    //Detaches the first node of the bucket
+    void popHead(int bucket) {
+        buckets[bucket] = buckets[bucket]->next;
+        if (!buckets[bucket]) tails[bucket] = nullptr;
+    }
+
+    //Finds the node with the minimal priority by scanning the heads of all buckets
+    CalendarNode<T>* directSearch() const {
+        CalendarNode<T>* best = nullptr;
+        for (CalendarNode<T>* head : buckets) {
+            if (head && (!best || head->priority < best->priority)) best = head;
+        }
+        return best;
+    }
+
+    //Estimates a bucket width from the gaps between the first events in priority order
+    int64_t sampleWidth() {
+        int sampleCount = std::min(n, SAMPLE_SIZE);
+        if (sampleCount < 2) return width;
+
+        std::vector<int> sample;
+        std::vector<CalendarNode<T>*> removed;
+        for (int i = 0; i < sampleCount; i++) {
+            removed.push_back(popMin());
+            sample.push_back(removed.back()->priority);
+        }
+        for (CalendarNode<T>* node : removed) {
+            insertNode(node);
+            n++;
+        }
+        moveTo(sample.front());
+
+        //Average gap, then the average again without the gaps that are far above it
+        double average = static_cast<double>(sample.back() - sample.front()) / (sampleCount - 1);
+        double total = 0;
+        int counted = 0;
+        for (int i = 1; i < sampleCount; i++) {
+            double gap = sample[i] - sample[i - 1];
+            if (gap <= 2 * average) {
+                total += gap;
+                counted++;
+            }
+        }
+        double separation = counted > 0 ? total / counted : average;
+        int64_t newWidth = static_cast<int64_t>(3 * separation);
+        return newWidth > 0 ? newWidth : 1;
+    }
+
+    //Rebuilds the calendar with a new number of buckets and a freshly sampled width
+    void resize(int newSize) {
+        int64_t newWidth = sampleWidth();
+
+        std::vector<CalendarNode<T>*> old;
+        old.swap(buckets);
+        buckets.assign(newSize, nullptr);
+        tails.assign(newSize, nullptr);
+        width = newWidth;
+        for (CalendarNode<T>* head : old) {
+            while (head) {
+                CalendarNode<T>* next = head->next;
+                insertNode(head);
+                head = next;
+            }
+        }
+        moveTo(lastPriority);
+    }
+
+    //Detaches the node with the minimal priority and advances the calendar to it
+    CalendarNode<T>* popMin() {
+        int count = static_cast<int>(buckets.size());
+        for (int i = 0; i < count; i++) {
+            CalendarNode<T>* head = buckets[lastBucket];
+            if (head && head->priority < bucketTop) {
+                popHead(lastBucket);
+                lastPriority = head->priority;
+                n--;
+                return head;
+            }
+            lastBucket = lastBucket + 1 == count ? 0 : lastBucket + 1;
+            bucketTop += width;
+        }
+
+        //A whole year passed without an event, jump straight to the minimum
+        CalendarNode<T>* best = directSearch();
+        moveTo(best->priority);
+        popHead(lastBucket);
+        n--;
+        return best;
+    }
+
+    //Walks the calendar like popMin without moving it
+    CalendarNode<T>* peekNode() const {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        int count = static_cast<int>(buckets.size());
+        int bucket = lastBucket;
+        int64_t top = bucketTop;
+        for (int i = 0; i < count; i++) {
+            CalendarNode<T>* head = buckets[bucket];
+            if (head && head->priority < top) return head;
+            bucket = bucket + 1 == count ? 0 : bucket + 1;
+            top += width;
+        }
+        return directSearch();
+    }
+
+public:
+    PriorityQueueCalendar()
+            : buckets(MIN_BUCKETS, nullptr), tails(MIN_BUCKETS, nullptr), width(1), lastPriority(0), lastBucket(0), bucketTop(1), n(0) {}
+
+    ~PriorityQueueCalendar() {
+        for (CalendarNode<T>* head : buckets) {
+            while (head) {
+                CalendarNode<T>* next = head->next;
+                delete head;
+                head = next;
+            }
+        }
+    }
+
+    void enqueue(T element, int priority) override {
+        insertNode(new CalendarNode<T>(element, priority));
+        n++;
+        if (priority < lastPriority) {
+            moveTo(priority);
+        }
+        if (n > 2 * static_cast<int>(buckets.size())) {
+            resize(2 * static_cast<int>(buckets.size()));
+        }
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        CalendarNode<T>* node = popMin();
+        T element = node->element;
+        delete node;
+        if (n < static_cast<int>(buckets.size()) / 2 && static_cast<int>(buckets.size()) > MIN_BUCKETS) {
+            resize(static_cast<int>(buckets.size()) / 2);
+        }
+        return element;
+    }
+
+    T peek() const override {
+        return peekNode()->element;
+    }
+
+    int peekPriority() const override {
+        return peekNode()->priority;
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        for (int bucket = 0; bucket < static_cast<int>(buckets.size()); bucket++) {
+            CalendarNode<T>* prev = nullptr;
+            for (CalendarNode<T>** link = &buckets[bucket]; *link; prev = *link, link = &(*link)->next) {
+                if ((*link)->element == element) {
+                    CalendarNode<T>* node = *link;
+                    *link = node->next;
+                    if (tails[bucket] == node) tails[bucket] = prev;
+                    node->priority = newPriority;
+                    insertNode(node);
+                    if (newPriority < lastPriority) {
+                        moveTo(newPriority);
+                    }
+                    return;
+                }
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (CalendarNode<T>* bucket : buckets) {
+            for (CalendarNode<T>* node = bucket; node; node = node->next) {
+                visit(node->element, node->priority);
+            }
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUECALENDAR_H
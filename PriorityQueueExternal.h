@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "ExternalRun.h"
+#include "LoserTree.h"
+
+#ifndef SD_P2_PRIORITYQUEUEEXTERNAL_H
+#define SD_P2_PRIORITYQUEUEEXTERNAL_H
+
+//External-memory priority queue – elements are kept in an in-memory heap sized by the memory budget,
+//and a full heap is written to the spill directory as a sorted run
+//Dequeue merges the heads of the runs with a loser tree and compares the winner with the heap's minimum,
+//a run and its file are dropped as soon as its last element has left
+//Once there are more than MAX_RUNS runs the MERGE_FAN_IN shortest are merged into one, so the number of open files
+//stays bounded and, as merged runs are of similar length, every element is rewritten only O(log runs) times
+//Elements are written to disk byte by byte and therefore have to be trivially copyable
+template <typename T>
+class PriorityQueueExternal : public PriorityQueue<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "Spilled elements are written to disk byte by byte");
+
+public:
+    static constexpr size_t MAX_RUNS = 64;
+    static constexpr size_t MERGE_FAN_IN = 16;
+
+private:
+    using Record = ExternalRecord<T>;
+
+    MinHeap<Node<T>> heap;
+    int heapCapacity;
+    std::vector<std::unique_ptr<ExternalRun<T>>> runs;
+    LoserTree<int> tree;
+    std::filesystem::path directory;
+    std::string filePrefix;
+    long long nextFile;
+    int n;
+
+    std::filesystem::path newRunPath() {
+        return directory / (filePrefix + std::to_string(nextFile++) + ".run");
+    }
+
+    //Forgets exhausted runs and starts a new tournament over the heads of the others
+    void rebuildTree() {
+        size_t kept = 0;
+        for (size_t i = 0; i < runs.size(); i++) {
+            if (!runs[i]->exhausted()) runs[kept++] = std::move(runs[i]);
+        }
+        runs.resize(kept);
+        std::vector<int> heads(runs.size());
+        std::vector<bool> active(runs.size(), true);
+        for (size_t i = 0; i < runs.size(); i++) {
+            heads[i] = runs[i]->head().priority;
+        }
+        tree.build(heads, active);
+    }
+
+    //Moves the winning run of tournament past its head and replays its path, returns whether the run is exhausted
+    static bool step(ExternalRun<T>& run, LoserTree<int>& tournament) {
+        run.advance();
+        if (run.exhausted()) {
+            tournament.exhaust();
+            return true;
+        }
+        tournament.replace(run.head().priority);
+        return false;
+    }
+
+    //Moves the winner's run past its head, an exhausted run is dropped together with its file
+    void advanceWinner() {
+        if (step(*runs[tree.winner()], tree)) rebuildTree();
+    }
+
+    //Writes the heap's content to a new run, the writer's buffer is the only copy made on the way
+    void spill() {
+        std::filesystem::path path = newRunPath();
+        ExternalRunWriter<T> writer(path);
+        while (!heap.empty()) {
+            Node<T> node = heap.extractMin();
+            writer.write(Record{node.priority, node.element});
+        }
+        size_t count = writer.close();
+        runs.push_back(std::make_unique<ExternalRun<T>>(path, count));
+        rebuildTree();
+        if (runs.size() > MAX_RUNS) mergeRuns();
+    }
+
+    //Streams the MERGE_FAN_IN shortest runs into a single new run
+    void mergeRuns() {
+        std::nth_element(runs.begin(), runs.begin() + (MERGE_FAN_IN - 1), runs.end(),
+                         [](const std::unique_ptr<ExternalRun<T>>& a, const std::unique_ptr<ExternalRun<T>>& b) {
+                             return a->remaining() < b->remaining();
+                         });
+        std::vector<std::unique_ptr<ExternalRun<T>>> merged;
+        for (size_t i = 0; i < MERGE_FAN_IN; i++) {
+            merged.push_back(std::move(runs[i]));
+        }
+        runs.erase(runs.begin(), runs.begin() + MERGE_FAN_IN);
+        std::vector<int> heads(merged.size());
+        std::vector<bool> active(merged.size(), true);
+        for (size_t i = 0; i < merged.size(); i++) {
+            heads[i] = merged[i]->head().priority;
+        }
+        LoserTree<int> merging;
+        merging.build(heads, active);
+        std::filesystem::path path = newRunPath();
+        ExternalRunWriter<T> writer(path);
+        while (merging.winner() >= 0) {
+            ExternalRun<T>& run = *merged[merging.winner()];
+            writer.write(run.head());
+            step(run, merging);
+        }
+        size_t count = writer.close();
+        merged.clear();
+        runs.push_back(std::make_unique<ExternalRun<T>>(path, count));
+        rebuildTree();
+    }
+
+    //Checks whether the next element to leave is the head of a run
+    bool minInRuns() const {
+        int winner = tree.winner();
+        if (winner < 0) return false;
+        return heap.empty() || tree.winnerKey() < heap.min().priority;
+    }
+
+public:
+    //The budget bounds the in-memory heap, the spill directory has to exist
+    explicit PriorityQueueExternal(size_t memoryBudget = size_t(64) << 20,
+                                   const std::filesystem::path& spillDirectory = std::filesystem::temp_directory_path())
+            : directory(spillDirectory), nextFile(0), n(0) {
+        if (!std::filesystem::is_directory(directory)) {
+            throw std::invalid_argument("Spill directory does not exist");
+        }
+        size_t capacity = memoryBudget / sizeof(Node<T>);
+        if (capacity < 1024) throw std::invalid_argument("Memory budget is too small");
+        heapCapacity = capacity > static_cast<size_t>(1 << 30) ? 1 << 30 : static_cast<int>(capacity);
+        heap = MinHeap<Node<T>>(heapCapacity);
+        filePrefix = "pq-" + std::to_string(std::random_device{}()) + "-";
+    }
+
+    PriorityQueueExternal(const PriorityQueueExternal& other) = delete;
+    PriorityQueueExternal& operator=(const PriorityQueueExternal& other) = delete;
+
+    void enqueue(T element, int priority) override {
+        if (heap.size() == heapCapacity) spill();
+        heap.insert(Node<T>(element, priority));
+        n++;
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        n--;
+        if (!minInRuns()) return heap.extractMin().element;
+        T element = runs[tree.winner()]->head().element;
+        advanceWinner();
+        return element;
+    }
+
+    T peek() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        if (minInRuns()) return runs[tree.winner()]->head().element;
+        return heap.min().element;
+    }
+
+    int peekPriority() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        if (minInRuns()) return tree.winnerKey();
+        return heap.min().priority;
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    //Elements in memory are changed in place, spilled ones are marked dead in their run and enqueued again
+    void modifyPriority(T element, int newPriority) override {
+        for (int i = 0; i < heap.size(); i++) {
+            if (heap.get(i).element == element) {
+                heap.replace(i, Node<T>(element, newPriority));
+                return;
+            }
+        }
+        for (std::unique_ptr<ExternalRun<T>>& run : runs) {
+            long long position = run->find(element);
+            if (position >= 0) {
+                run->kill(static_cast<size_t>(position));
+                rebuildTree();
+                n--;
+                enqueue(element, newPriority);
+                return;
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    //Spilled elements are read back from their runs
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (int i = 0; i < heap.size(); i++) {
+            visit(heap.get(i).element, heap.get(i).priority);
+        }
+        for (const std::unique_ptr<ExternalRun<T>>& run : runs) {
+            run->forEach(visit);
+        }
+    }
+
+    //Number of runs currently on disk
+    int runCount() const {
+        return static_cast<int>(runs.size());
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEEXTERNAL_H
@@ -1,6 +1,7 @@
 ﻿#include <stdexcept>
 #include <algorithm>
 #include <vector>
+#include <utility>
 #include "PriorityQueue.h"
 #ifndef SD_P2_PRIORITYQUEUEFIBONACCIHEAP_H
 #define SD_P2_PRIORITYQUEUEFIBONACCIHEAP_H
@@ -255,6 +256,11 @@ public:
         return minNode->element;
     }
 
+    int peekPriority() const override {
+        if (!minNode) throw std::runtime_error("Peek: Heap is empty");
+        return minNode->priority;
+    }
+
     int getSize() const{
         return n;
     }
@@ -310,6 +316,50 @@ public:
     bool isEmpty() const {
         return minNode == nullptr;
     }
+
+    //Walks every circular sibling list, descending into the children of each node
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        if (!minNode) return;
+        std::vector<FibNode<T>*> stack;
+        stack.push_back(minNode);
+        while (!stack.empty()) {
+            FibNode<T>* start = stack.back();
+            stack.pop_back();
+            FibNode<T>* current = start;
+            do {
+                visit(current->element, current->priority);
+                if (current->child) stack.push_back(current->child);
+                current = current->right;
+            } while (current != start);
+        }
+    }
+
+    //Splices the root list of the other heap into this one in O(1)
+    void meld(PriorityQueue<T>&& other) override {
+        auto* same = dynamic_cast<PriorityQueueFibonacciHeap<T>*>(&other);
+        if (!same) {
+            PriorityQueue<T>::meld(std::move(other));
+            return;
+        }
+        if (same == this || !same->minNode) return;
+
+        if (!minNode) {
+            minNode = same->minNode;
+        } else {
+            FibNode<T>* right = minNode->right;
+            FibNode<T>* otherLeft = same->minNode->left;
+            minNode->right = same->minNode;
+            same->minNode->left = minNode;
+            otherLeft->right = right;
+            right->left = otherLeft;
+            if (same->minNode->priority < minNode->priority) {
+                minNode = same->minNode;
+            }
+        }
+        n += same->n;
+        same->minNode = nullptr;
+        same->n = 0;
+    }
 };
 
 #endif //SD_P2_PRIORITYQUEUEFIBONACCIHEAP_H
@@ -0,0 +1,303 @@
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "PriorityQueue.h"
+#include "ConcurrentSync.h"
+
+#ifndef SD_P2_PRIORITYQUEUEFINEGRAINEDHEAP_H
+#define SD_P2_PRIORITYQUEUEFINEGRAINEDHEAP_H
+
+//Concurrent binary heap with a lock per node after Hunt, Michael, Parthasarathy and Scott
+//The nodes keep the implicit layout of MinHeap, 1-based, so the children of node i are 2i and 2i+1
+//A short global lock only hands out the next free slot or the last element; the slots of one level are taken in
+//bit-reversed order, so consecutive inserts start in different subtrees and climb without meeting
+//Insertion sifts up bottom-up and deletion sifts down top-down at the same time; both always lock a parent
+//before its child, and an inserted element carries the tag of its thread until it has settled, so the inserter
+//can follow it when a deletion moves it up
+//Every level is an array of its own allocated on first use and never moved, so the heap grows while other
+//threads hold locks on its nodes
+template <typename T>
+class PriorityQueueFineGrainedHeap : public PriorityQueue<T> {
+private:
+    static constexpr int MAX_LEVELS = 31;
+    static constexpr int EMPTY = 0; //Tag of a node without an element
+    static constexpr int AVAILABLE = 1; //Tag of a node whose element has settled, inserting threads use 2 and up
+
+    struct HeapNode {
+        SpinLockSync lock;
+        int tag = EMPTY;
+        int priority = 0;
+        T element{};
+    };
+
+    std::atomic<HeapNode*> levels[MAX_LEVELS];
+    SpinLockSync heapLock;
+    int count; //Guarded by heapLock
+    std::atomic<int> size; //Copy of count readable without the lock
+
+    static int level(int index) {
+        return std::bit_width(static_cast<unsigned>(index)) - 1;
+    }
+
+    HeapNode& node(int index) const {
+        int l = level(index);
+        return levels[l].load(std::memory_order_acquire)[index - (1 << l)];
+    }
+
+    //Whether the level of index has been allocated, a node of a level that has not is empty
+    bool exists(int index) const {
+        int l = level(index);
+        return l < MAX_LEVELS && levels[l].load(std::memory_order_acquire) != nullptr;
+    }
+
+    //Slot of the n-th element: the offset within its level with the bits reversed
+    static int slot(int n) {
+        int l = level(n);
+        unsigned offset = static_cast<unsigned>(n - (1 << l));
+        unsigned reversed = 0;
+        for (int i = 0; i < l; i++) {
+            reversed = (reversed << 1) | ((offset >> i) & 1);
+        }
+        return (1 << l) | static_cast<int>(reversed);
+    }
+
+    static int ownTag() {
+        return ThreadIndex::current() + 2;
+    }
+
+    static void swapContents(HeapNode& a, HeapNode& b) {
+        std::swap(a.tag, b.tag);
+        std::swap(a.priority, b.priority);
+        std::swap(a.element, b.element);
+    }
+
+    //Moves the element tagged with tag up from index until it has settled, following it if a deletion moved it
+    void siftUp(int index, int tag) {
+        int i = index;
+        SpinWait spin;
+        while (i > 1) {
+            int parent = i / 2;
+            HeapNode& up = node(parent);
+            HeapNode& cur = node(i);
+            {
+                std::lock_guard<SpinLockSync> parentGuard(up.lock);
+                std::lock_guard<SpinLockSync> childGuard(cur.lock);
+                if (up.tag == AVAILABLE && cur.tag == tag) {
+                    if (cur.priority < up.priority) {
+                        swapContents(cur, up);
+                        i = parent;
+                        continue;
+                    }
+                    cur.tag = AVAILABLE;
+                    return;
+                }
+                if (up.tag == EMPTY) return; //A deletion took the element away as the last one
+                if (cur.tag != tag) {
+                    i = parent; //A deletion moved the element up
+                    continue;
+                }
+            }
+            //The parent is still settling an insert of another thread, wait for it without holding a lock
+            spin.wait();
+        }
+        HeapNode& root = node(1);
+        std::lock_guard<SpinLockSync> guard(root.lock);
+        if (root.tag == tag) root.tag = AVAILABLE;
+    }
+
+    //Moves the element at index down, index is locked on entry and every lock is released on return
+    void siftDown(int index) {
+        int i = index;
+        while (true) {
+            int left = 2 * i;
+            int right = left + 1;
+            HeapNode& cur = node(i);
+            if (level(i) == MAX_LEVELS - 1 || !exists(left)) {
+                cur.lock.unlock();
+                return;
+            }
+            HeapNode& l = node(left);
+            HeapNode& r = node(right);
+            l.lock.lock();
+            r.lock.lock();
+            HeapNode* child;
+            int childIndex;
+            if (l.tag == EMPTY) {
+                r.lock.unlock();
+                l.lock.unlock();
+                cur.lock.unlock();
+                return;
+            } else if (r.tag == EMPTY || l.priority < r.priority) {
+                r.lock.unlock();
+                child = &l;
+                childIndex = left;
+            } else {
+                l.lock.unlock();
+                child = &r;
+                childIndex = right;
+            }
+            if (child->priority < cur.priority) {
+                swapContents(*child, cur);
+                cur.lock.unlock();
+                i = childIndex;
+            } else {
+                child->lock.unlock();
+                cur.lock.unlock();
+                return;
+            }
+        }
+    }
+
+    //Takes the element of the last slot out, returns false if the heap is empty
+    bool takeLast(T& element, int& priority, int& taken) {
+        heapLock.lock();
+        if (count == 0) {
+            heapLock.unlock();
+            return false;
+        }
+        taken = slot(count--);
+        size.store(count, std::memory_order_relaxed);
+        HeapNode& bottom = node(taken);
+        std::lock_guard<SpinLockSync> guard(bottom.lock);
+        heapLock.unlock();
+        element = std::move(bottom.element);
+        priority = bottom.priority;
+        bottom.tag = EMPTY;
+        return true;
+    }
+
+public:
+    PriorityQueueFineGrainedHeap() : count(0), size(0) {
+        for (std::atomic<HeapNode*>& l : levels) {
+            l.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~PriorityQueueFineGrainedHeap() {
+        for (std::atomic<HeapNode*>& l : levels) {
+            delete[] l.load(std::memory_order_relaxed);
+        }
+    }
+
+    PriorityQueueFineGrainedHeap(const PriorityQueueFineGrainedHeap&) = delete;
+    PriorityQueueFineGrainedHeap& operator=(const PriorityQueueFineGrainedHeap&) = delete;
+
+    void enqueue(T element, int priority) override {
+        int tag = ownTag();
+        heapLock.lock();
+        if (count == INT_MAX) {
+            heapLock.unlock();
+            throw std::length_error("Heap is full");
+        }
+        int i = slot(++count);
+        size.store(count, std::memory_order_relaxed);
+        int l = level(i);
+        if (levels[l].load(std::memory_order_relaxed) == nullptr) {
+            levels[l].store(new HeapNode[static_cast<size_t>(1) << l], std::memory_order_release);
+        }
+        HeapNode& slotNode = node(i);
+        slotNode.lock.lock();
+        heapLock.unlock();
+        slotNode.element = std::move(element);
+        slotNode.priority = priority;
+        slotNode.tag = tag;
+        slotNode.lock.unlock();
+        siftUp(i, tag);
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes the most urgent element into element, returns false if the queue is empty
+    //The last element replaces the root and sinks from there
+    bool tryDequeue(T& element) {
+        T last;
+        int priority;
+        int taken;
+        if (!takeLast(last, priority, taken)) return false;
+        if (taken == 1) {
+            element = std::move(last);
+            return true;
+        }
+        HeapNode& root = node(1);
+        root.lock.lock();
+        if (root.tag == EMPTY) {
+            //Other deletions emptied the heap meanwhile, the last element was the only one left
+            root.lock.unlock();
+            element = std::move(last);
+            return true;
+        }
+        element = std::move(root.element);
+        root.element = std::move(last);
+        root.priority = priority;
+        root.tag = AVAILABLE;
+        siftDown(1);
+        return true;
+    }
+
+    T peek() const override {
+        if (!exists(1)) throw std::runtime_error("Queue is empty");
+        HeapNode& root = node(1);
+        std::lock_guard<SpinLockSync> guard(root.lock);
+        if (root.tag == EMPTY) throw std::runtime_error("Queue is empty");
+        return root.element;
+    }
+
+    int peekPriority() const override {
+        if (!exists(1)) throw std::runtime_error("Queue is empty");
+        HeapNode& root = node(1);
+        std::lock_guard<SpinLockSync> guard(root.lock);
+        if (root.tag == EMPTY) throw std::runtime_error("Queue is empty");
+        return root.priority;
+    }
+
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    //Finds the element one node at a time, so an element that concurrent operations move meanwhile may be missed
+    //A smaller priority sifts up like an insert, a larger one sinks like after a deletion
+    void modifyPriority(T element, int newPriority) override {
+        for (int i = 1; exists(i); i++) {
+            HeapNode& cur = node(i);
+            cur.lock.lock();
+            if (cur.tag != AVAILABLE || !(cur.element == element)) {
+                cur.lock.unlock();
+                continue;
+            }
+            if (newPriority < cur.priority) {
+                int tag = ownTag();
+                cur.priority = newPriority;
+                cur.tag = tag;
+                cur.lock.unlock();
+                siftUp(i, tag);
+            } else {
+                cur.priority = newPriority;
+                siftDown(i);
+            }
+            return;
+        }
+    }
+
+    bool isEmpty() const override {
+        return getSize() == 0;
+    }
+
+    //Locks one node at a time, so it is a consistent picture only while no other thread changes the queue
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (int i = 1; exists(i); i++) {
+            HeapNode& cur = node(i);
+            std::lock_guard<SpinLockSync> guard(cur.lock);
+            if (cur.tag != EMPTY) visit(cur.element, cur.priority);
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEFINEGRAINEDHEAP_H
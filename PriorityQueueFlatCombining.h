@@ -0,0 +1,182 @@
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "ConcurrentSync.h"
+
+#ifndef SD_P2_PRIORITYQUEUEFLATCOMBINING_H
+#define SD_P2_PRIORITYQUEUEFLATCOMBINING_H
+
+//Binary heap shared between threads through flat combining
+//Threads publish enqueue and dequeue requests in per-thread slots and whichever thread becomes the combiner
+//serves all of them in one pass: the enqueued nodes go into the heap with one insertBulk, which sifts them up
+//one by one or rebuilds the heap bottom-up (Floyd) when the batch is large, and the dequeues take the minima after it
+//Unlike ConcurrentPriorityQueue with FlatCombiningSync, the combiner sees what the requests are and can batch them
+template <typename T>
+class PriorityQueueFlatCombining : public PriorityQueue<T> {
+private:
+    enum class RequestKind {
+        Enqueue,
+        Dequeue
+    };
+
+    struct Request {
+        RequestKind kind;
+        T element;
+        int priority;
+        bool served; //Whether a dequeue found an element
+        std::exception_ptr error; //Exception of the batch insert an enqueue was part of
+        std::atomic<bool> done{false};
+    };
+
+    MinHeap<Node<T>> heap;
+    DynamicArray<Node<T>> batch; //Nodes enqueued in the current pass
+    std::vector<int> enqueues; //Slots holding enqueue requests of the current pass
+    std::vector<int> dequeues; //Slots holding dequeue requests of the current pass
+    std::atomic<int> size;
+    mutable PublicationSlots<Request> slots;
+
+    void publishAndWait(Request& request) {
+        slots.publishAndWait(request, [this] { return servePass(); });
+    }
+
+    //Serves the published requests once, enqueues of a pass are linearized before its dequeues
+    //Nobody is let go before size is stored, so a thread returning from a call sees its own effect on it
+    //Returns whether there were any
+    bool servePass() {
+        int used = slots.used();
+        for (int i = 0; i < used; i++) {
+            Request* request = slots.published(i);
+            if (!request) continue;
+            if (request->kind == RequestKind::Enqueue) {
+                batch.pushBack(Node<T>(request->element, request->priority));
+                enqueues.push_back(i);
+            } else {
+                dequeues.push_back(i);
+            }
+        }
+        if (enqueues.empty() && dequeues.empty()) return false;
+
+        std::exception_ptr error;
+        try {
+            heap.insertBulk(batch);
+        } catch (...) {
+            error = std::current_exception(); //Handed to the enqueues of the batch, the dequeues are served anyway
+        }
+        batch.clear();
+        for (int i : dequeues) {
+            Request* request = slots.published(i); //Still published, the slot is freed by finish
+            request->served = !heap.empty();
+            if (request->served) request->element = heap.extractMin().element;
+        }
+        size.store(heap.size(), std::memory_order_relaxed);
+        for (int i : enqueues) {
+            Request* request = slots.published(i);
+            request->error = error;
+            slots.finish(i, request);
+        }
+        for (int i : dequeues) {
+            slots.finish(i, slots.published(i));
+        }
+        enqueues.clear();
+        dequeues.clear();
+        return true;
+    }
+
+    //Runs operation as the combiner, for the operations that are not batched
+    template <typename F>
+    auto exclusive(F&& operation) const {
+        return slots.exclusive(std::forward<F>(operation));
+    }
+
+public:
+    PriorityQueueFlatCombining() : size(0) {}
+
+    void enqueue(T element, int priority) override {
+        Request request;
+        request.kind = RequestKind::Enqueue;
+        request.element = std::move(element);
+        request.priority = priority;
+        publishAndWait(request);
+        if (request.error) std::rethrow_exception(request.error);
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes the most urgent element into element, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        Request request;
+        request.kind = RequestKind::Dequeue;
+        request.served = false;
+        publishAndWait(request);
+        if (request.served) element = std::move(request.element);
+        return request.served;
+    }
+
+    T peek() const override {
+        return exclusive([this] {
+            if (heap.empty()) throw std::runtime_error("Queue is empty");
+            return heap.min().element;
+        });
+    }
+
+    int peekPriority() const override {
+        return exclusive([this] {
+            if (heap.empty()) throw std::runtime_error("Queue is empty");
+            return heap.min().priority;
+        });
+    }
+
+    //Size after the last combining pass, it may lag behind requests that are being served
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        exclusive([&] {
+            for (int i = 0; i < heap.size(); i++) {
+                if (heap.get(i).element == element) {
+                    Node<T> node = heap.get(i);
+                    node.priority = newPriority;
+                    heap.replace(i, node);
+                    return;
+                }
+            }
+        });
+    }
+
+    bool isEmpty() const override {
+        return getSize() == 0;
+    }
+
+    //Visit runs while the queue is locked and must not call back into it
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        exclusive([&] {
+            for (int i = 0; i < heap.size(); i++) {
+                visit(heap.get(i).element, heap.get(i).priority);
+            }
+        });
+    }
+
+protected:
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        DynamicArray<Node<T>> nodes(static_cast<int>(entries.size()));
+        for (SnapshotEntry<T>& entry : entries) {
+            nodes.pushBack(Node<T>(entry.element, entry.priority));
+        }
+        exclusive([&] {
+            heap.insertBulk(nodes);
+            size.store(heap.size(), std::memory_order_relaxed);
+        });
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEFLATCOMBINING_H
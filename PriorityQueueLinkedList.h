@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 #include "PriorityQueue.h"
 
 #ifndef SD_P2_PRIORITYQUEUELINKEDLIST_H
@@ -62,6 +64,11 @@ public:
         return head->element;
     }
 
+    int peekPriority() const override {
+        if (!head) throw std::runtime_error("Queue is empty");
+        return head->priority;
+    }
+
     void modifyPriority(T element, int newPriority) {
         if (!head) return;
 
@@ -91,6 +98,53 @@ public:
     bool isEmpty() const{
         return head == nullptr;
     }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (LinkedNode<T>* current = head; current; current = current->next) {
+            visit(current->element, current->priority);
+        }
+    }
+
+    //Merges two sorted lists in one linear pass, on equal priorities the elements of this list stay first
+    void meld(PriorityQueue<T>&& other) override {
+        auto* same = dynamic_cast<PriorityQueueLinkedList<T>*>(&other);
+        if (!same) {
+            PriorityQueue<T>::meld(std::move(other));
+            return;
+        }
+        if (same == this) return;
+
+        LinkedNode<T>* first = head;
+        LinkedNode<T>* second = same->head;
+        LinkedNode<T>** tail = &head;
+        while (first && second) {
+            if (second->priority < first->priority) {
+                *tail = second;
+                second = second->next;
+            } else {
+                *tail = first;
+                first = first->next;
+            }
+            tail = &(*tail)->next;
+        }
+        *tail = first ? first : second;
+        same->head = nullptr;
+    }
+
+protected:
+    //Sorts the batch once and builds a list from it, which is then merged with this one
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        std::stable_sort(entries.begin(), entries.end(), [](const SnapshotEntry<T>& a, const SnapshotEntry<T>& b) {
+            return a.priority < b.priority;
+        });
+        PriorityQueueLinkedList<T> loaded;
+        LinkedNode<T>** tail = &loaded.head;
+        for (SnapshotEntry<T>& entry : entries) {
+            *tail = new LinkedNode<T>(entry.element, entry.priority);
+            tail = &(*tail)->next;
+        }
+        meld(std::move(loaded));
+    }
 };
 
 #endif //SD_P2_PRIORITYQUEUELINKEDLIST_H
@@ -0,0 +1,290 @@
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "PriorityQueue.h"
+#include "ConcurrentSync.h"
+#include "EpochReclaimer.h"
+
+#ifndef SD_P2_PRIORITYQUEUELOCKFREESKIPLIST_H
+#define SD_P2_PRIORITYQUEUELOCKFREESKIPLIST_H
+
+//Lock-free priority queue on a skip list after Lindén and Jonsson
+//A node is deleted logically by setting the lowest bit of the level 0 pointer of its predecessor, so the deleted
+//nodes always form a prefix of the list and dequeue claims the next node with a single fetch-or
+//The prefix is cut off physically only once it is longer than BOUND_OFFSET, with one CAS on the head,
+//which keeps dequeuing threads from fighting over the same pointers
+//Cut-off nodes are handed to an epoch reclaimer, so no thread that is still walking them sees them deleted
+template <typename T>
+class PriorityQueueLockFreeSkipList : public PriorityQueue<T> {
+private:
+    static constexpr int MAX_LEVEL = 24;
+    static constexpr int BOUND_OFFSET = 32;
+
+    //A node that modifyPriority took away is skipped by dequeue, whoever takes the node first owns its element
+    enum NodeState {
+        Live,
+        Taken
+    };
+
+    struct SkipNode {
+        int priority;
+        int level;
+        std::atomic<bool> inserting; //Set until all levels are linked, the prefix is never cut behind such a node
+        std::atomic<int> state;
+        T element;
+        std::atomic<uintptr_t>* next; //Level pointers stored behind the node in the same allocation
+
+        SkipNode(int priority, int level, T element)
+            : priority(priority), level(level), inserting(true), state(Live), element(std::move(element)), next(nullptr) {}
+    };
+
+    SkipNode* head;
+    SkipNode* tail;
+    mutable EpochReclaimer reclaimer;
+    std::atomic<int> size;
+
+    static SkipNode* pointer(uintptr_t link) {
+        return reinterpret_cast<SkipNode*>(link & ~uintptr_t(1));
+    }
+
+    static bool marked(uintptr_t link) {
+        return (link & 1) != 0;
+    }
+
+    static uintptr_t link(SkipNode* node, bool mark = false) {
+        return reinterpret_cast<uintptr_t>(node) | (mark ? 1 : 0);
+    }
+
+    static SkipNode* createNode(int priority, int level, T element) {
+        constexpr size_t offset = (sizeof(SkipNode) + alignof(std::atomic<uintptr_t>) - 1) / alignof(std::atomic<uintptr_t>)
+            * alignof(std::atomic<uintptr_t>);
+        char* memory = static_cast<char*>(::operator new(offset + level * sizeof(std::atomic<uintptr_t>)));
+        SkipNode* node = new (memory) SkipNode(priority, level, std::move(element));
+        node->next = reinterpret_cast<std::atomic<uintptr_t>*>(memory + offset);
+        for (int i = 0; i < level; i++) {
+            new (&node->next[i]) std::atomic<uintptr_t>(0);
+        }
+        return node;
+    }
+
+    static void destroyNode(void* memory) {
+        SkipNode* node = static_cast<SkipNode*>(memory);
+        node->~SkipNode();
+        ::operator delete(memory);
+    }
+
+    //Levels are geometric with ratio 1/2, drawn from a per-thread xorshift generator
+    static int randomLevel() {
+        return 1 + std::countr_zero(ThreadRandom::next() | (1u << (MAX_LEVEL - 1)));
+    }
+
+    //Finds the neighbours of priority on every level behind the deleted prefix, returns the last deleted node passed
+    SkipNode* locatePreds(int priority, SkipNode** preds, SkipNode** succs) const {
+        SkipNode* deleted = nullptr;
+        SkipNode* pred = head;
+        for (int i = MAX_LEVEL - 1; i >= 0; i--) {
+            SkipNode* cur = pointer(pred->next[i].load(std::memory_order_acquire));
+            bool d = marked(pred->next[0].load(std::memory_order_acquire));
+            while (cur != tail && (cur->priority < priority || marked(cur->next[0].load(std::memory_order_acquire)) || (i == 0 && d))) {
+                if (d && i == 0) deleted = cur;
+                pred = cur;
+                cur = pointer(pred->next[i].load(std::memory_order_acquire));
+                d = marked(pred->next[0].load(std::memory_order_acquire));
+            }
+            preds[i] = pred;
+            succs[i] = cur;
+        }
+        return deleted;
+    }
+
+    //Moves the upper head pointers past the nodes of the deleted prefix
+    void restructure() {
+        SkipNode* pred = head;
+        int i = MAX_LEVEL - 1;
+        while (i > 0) {
+            uintptr_t first = head->next[i].load(std::memory_order_acquire);
+            if (!marked(pointer(first)->next[0].load(std::memory_order_acquire))) {
+                i--;
+                continue;
+            }
+            SkipNode* cur = pointer(pred->next[i].load(std::memory_order_acquire));
+            while (marked(cur->next[0].load(std::memory_order_acquire))) {
+                pred = cur;
+                cur = pointer(pred->next[i].load(std::memory_order_acquire));
+            }
+            if (head->next[i].compare_exchange_strong(first, pred->next[i].load(std::memory_order_acquire), std::memory_order_acq_rel)) {
+                i--;
+            }
+        }
+    }
+
+    //First node behind the deleted prefix that has not been taken, or tail
+    SkipNode* firstLive() const {
+        SkipNode* x = head;
+        while (true) {
+            uintptr_t next = x->next[0].load(std::memory_order_acquire);
+            SkipNode* cur = pointer(next);
+            if (cur == tail) return tail;
+            if (!marked(next) && cur->state.load(std::memory_order_acquire) == Live) return cur;
+            x = cur;
+        }
+    }
+
+public:
+    PriorityQueueLockFreeSkipList() : size(0) {
+        head = createNode(INT_MIN, MAX_LEVEL, T());
+        tail = createNode(INT_MAX, MAX_LEVEL, T());
+        for (int i = 0; i < MAX_LEVEL; i++) {
+            head->next[i].store(link(tail), std::memory_order_relaxed);
+        }
+        head->inserting.store(false, std::memory_order_relaxed);
+        tail->inserting.store(false, std::memory_order_relaxed);
+    }
+
+    //No thread may use the queue anymore, the cut-off nodes are deleted by the reclaimer
+    ~PriorityQueueLockFreeSkipList() {
+        SkipNode* cur = pointer(head->next[0].load(std::memory_order_relaxed));
+        while (cur != tail) {
+            SkipNode* next = pointer(cur->next[0].load(std::memory_order_relaxed));
+            destroyNode(cur);
+            cur = next;
+        }
+        destroyNode(head);
+        destroyNode(tail);
+    }
+
+    PriorityQueueLockFreeSkipList(const PriorityQueueLockFreeSkipList&) = delete;
+    PriorityQueueLockFreeSkipList& operator=(const PriorityQueueLockFreeSkipList&) = delete;
+
+    void enqueue(T element, int priority) override {
+        EpochGuard guard(reclaimer);
+        int level = randomLevel();
+        SkipNode* node = createNode(priority, level, std::move(element));
+        SkipNode* preds[MAX_LEVEL];
+        SkipNode* succs[MAX_LEVEL];
+        size.fetch_add(1, std::memory_order_relaxed);
+
+        SkipNode* deleted;
+        while (true) {
+            deleted = locatePreds(priority, preds, succs);
+            node->next[0].store(link(succs[0]), std::memory_order_relaxed);
+            uintptr_t expected = link(succs[0]);
+            if (preds[0]->next[0].compare_exchange_strong(expected, link(node), std::memory_order_acq_rel)) break;
+        }
+
+        //Upper levels are only shortcuts, linking them stops as soon as the node or its successor gets deleted
+        int i = 1;
+        while (i < level) {
+            node->next[i].store(link(succs[i]), std::memory_order_relaxed);
+            if (marked(node->next[0].load(std::memory_order_acquire)) || marked(succs[i]->next[0].load(std::memory_order_acquire))
+                || deleted == succs[i]) {
+                break;
+            }
+            uintptr_t expected = link(succs[i]);
+            if (preds[i]->next[i].compare_exchange_strong(expected, link(node), std::memory_order_acq_rel)) {
+                i++;
+            } else {
+                deleted = locatePreds(priority, preds, succs);
+                if (succs[0] != node) break;
+            }
+        }
+        node->inserting.store(false, std::memory_order_release);
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes the most urgent element into element, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        EpochGuard guard(reclaimer);
+        SkipNode* x = head;
+        SkipNode* newHead = nullptr;
+        int offset = 0;
+        uintptr_t observedHead = head->next[0].load(std::memory_order_acquire);
+        while (true) {
+            uintptr_t next;
+            do {
+                next = x->next[0].load(std::memory_order_acquire);
+                if (pointer(next) == tail) return false;
+                if (!newHead && x->inserting.load(std::memory_order_acquire)) newHead = x;
+                next = x->next[0].fetch_or(1, std::memory_order_acq_rel);
+                offset++;
+                x = pointer(next);
+            } while (marked(next));
+            if (x->state.exchange(Taken, std::memory_order_acq_rel) == Live) break;
+        }
+        element = x->element;
+        size.fetch_sub(1, std::memory_order_relaxed);
+        if (offset < BOUND_OFFSET) return true;
+
+        //Cut the prefix up to the first node that is still being inserted, or up to the node just deleted
+        if (!newHead) newHead = x;
+        if (head->next[0].compare_exchange_strong(observedHead, link(newHead, true), std::memory_order_acq_rel)) {
+            restructure();
+            SkipNode* cur = pointer(observedHead);
+            while (cur != newHead) {
+                SkipNode* next = pointer(cur->next[0].load(std::memory_order_relaxed));
+                reclaimer.retire(cur, &destroyNode);
+                cur = next;
+            }
+        }
+        return true;
+    }
+
+    T peek() const override {
+        EpochGuard guard(reclaimer);
+        SkipNode* first = firstLive();
+        if (first == tail) throw std::runtime_error("Queue is empty");
+        return first->element;
+    }
+
+    int peekPriority() const override {
+        EpochGuard guard(reclaimer);
+        SkipNode* first = firstLive();
+        if (first == tail) throw std::runtime_error("Queue is empty");
+        return first->priority;
+    }
+
+    //Number of elements enqueued and not dequeued, an enqueue is counted as soon as it starts
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    //The node of the element is taken like a dequeue would take it and the element is enqueued again
+    void modifyPriority(T element, int newPriority) override {
+        EpochGuard guard(reclaimer);
+        for (SkipNode* cur = firstLive(); cur != tail; cur = pointer(cur->next[0].load(std::memory_order_acquire))) {
+            if (cur->state.load(std::memory_order_acquire) != Live || !(cur->element == element)) continue;
+            int expected = Live;
+            if (cur->state.compare_exchange_strong(expected, Taken, std::memory_order_acq_rel)) {
+                size.fetch_sub(1, std::memory_order_relaxed);
+                enqueue(element, newPriority);
+            }
+            return;
+        }
+    }
+
+    bool isEmpty() const override {
+        EpochGuard guard(reclaimer);
+        return firstLive() == tail;
+    }
+
+    //Visits the elements in priority order, elements enqueued or dequeued meanwhile may or may not be seen
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        EpochGuard guard(reclaimer);
+        for (SkipNode* cur = firstLive(); cur != tail; cur = pointer(cur->next[0].load(std::memory_order_acquire))) {
+            if (cur->state.load(std::memory_order_acquire) == Live) visit(cur->element, cur->priority);
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUELOCKFREESKIPLIST_H
@@ -3,6 +3,7 @@
 
 #include "PriorityQueue.h"
 #include "MinHeap.h"
+#include <utility>
 
 template <typename T>
 struct Node {
@@ -29,17 +30,7 @@ struct Node {
 	bool operator>=(const Node& other) const {
 		return priority >= other.priority;
 	}
-	
-	Node& operator=(const Node& other) {
-		if (this != &other) {
-			element = other.element;
-			priority = other.priority;
-			next = other.next;
-		}
-		return *this;
-	}
-
-	Node(const Node& other) : element(other.element), priority(other.priority), next(other.next) {}
+	//Copying is left to the compiler, so Node of a trivially copyable type stays trivially copyable
 };
 
 template <typename T>
@@ -69,6 +60,9 @@ public:
 		Node<T> node = heap->min();
 		return node.element;
 	}
+	int peekPriority() const override {
+		return heap->min().priority;
+	}
 	int getSize() const override {
 		return heap->size();
 	}
@@ -93,6 +87,58 @@ public:
     bool isEmpty() const{
         return (getSize() == 0);
     }
+
+	//Melding another heap appends its array and lets MinHeap decide between sifting up and a full rebuild
+	void meld(PriorityQueue<T>&& other) override {
+		auto* same = dynamic_cast<PriorityQueueMinHeap<T>*>(&other);
+		if (!same) {
+			PriorityQueue<T>::meld(std::move(other));
+			return;
+		}
+		if (same != this)
+			heap->merge(*same->heap);
+	}
+
+	//Visits the elements in the order of the heap array
+	void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+		for (int i = 0; i < heap->size(); ++i) {
+			const Node<T>& node = heap->get(i);
+			visit(node.element, node.priority);
+		}
+	}
+
+	//Writes the heap array as it is, so loading it into an empty heap needs no heapify
+	void saveSnapshot(const std::string& path) const override {
+		SnapshotWriter<T> writer(path, SnapshotLayout::HeapArray);
+		for (int i = 0; i < heap->size(); ++i) {
+			const Node<T>& node = heap->get(i);
+			writer.write(node.element, node.priority);
+		}
+		writer.close();
+	}
+
+	//A heap array loaded into an empty heap is taken over as it is, anything else is built bottom-up
+	void loadSnapshot(const std::string& path) override {
+		SnapshotReader<T> reader(path);
+		DynamicArray<Node<T>> nodes(static_cast<int>(reader.count()));
+		for (uint64_t i = 0; i < reader.count(); ++i) {
+			SnapshotEntry<T> entry = reader.read();
+			nodes.pushBack(Node<T>(entry.element, entry.priority));
+		}
+		if (heap->empty() && reader.layout() == SnapshotLayout::HeapArray)
+			heap->assign(nodes);
+		else
+			heap->insertBulk(nodes);
+	}
+
+protected:
+	void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+		DynamicArray<Node<T>> nodes(static_cast<int>(entries.size()));
+		for (SnapshotEntry<T>& entry : entries) {
+			nodes.pushBack(Node<T>(entry.element, entry.priority));
+		}
+		heap->insertBulk(nodes);
+	}
 };
 
 #endif // !PRIORITY_QUEUE_MIN_HEAP_H
@@ -0,0 +1,95 @@
+#include <stdexcept>
+#include <utility>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "MinMaxHeap.h"
+
+#ifndef SD_P2_PRIORITYQUEUEMINMAXHEAP_H
+#define SD_P2_PRIORITYQUEUEMINMAXHEAP_H
+
+//Double-ended priority queue on a min-max heap
+//Both the most urgent and the least urgent element are reachable in O(1) and removable in O(log n),
+//so a consumer can take from the head while a load-shedder evicts from the tail
+template <typename T>
+class PriorityQueueMinMaxHeap : public PriorityQueue<T> {
+private:
+    MinMaxHeap<Node<T>> heap;
+
+    int indexOf(const T& element) const {
+        for (int i = 0; i < heap.size(); i++) {
+            if (heap.get(i).element == element) return i;
+        }
+        return -1;
+    }
+
+public:
+    PriorityQueueMinMaxHeap() = default;
+
+    void enqueue(T element, int priority) override {
+        heap.insert(Node<T>(element, priority));
+    }
+
+    //Removes the element with the lowest priority value
+    T dequeueMin() {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.extractMin().element;
+    }
+
+    //Removes the element with the highest priority value
+    T dequeueMax() {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.extractMax().element;
+    }
+
+    T peekMin() const {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.min().element;
+    }
+
+    T peekMax() const {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.max().element;
+    }
+
+    int peekMaxPriority() const {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.max().priority;
+    }
+
+    T dequeue() override {
+        return dequeueMin();
+    }
+
+    T peek() const override {
+        return peekMin();
+    }
+
+    int peekPriority() const override {
+        if (heap.empty()) throw std::runtime_error("Queue is empty");
+        return heap.min().priority;
+    }
+
+    int getSize() const override {
+        return heap.size();
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        int index = indexOf(element);
+        if (index == -1) return;
+        Node<T> node = heap.get(index);
+        node.priority = newPriority;
+        heap.replace(index, node);
+    }
+
+    bool isEmpty() const override {
+        return heap.empty();
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (int i = 0; i < heap.size(); i++) {
+            visit(heap.get(i).element, heap.get(i).priority);
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEMINMAXHEAP_H
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "ConcurrentSync.h"
+#include "RankErrorMeter.h"
+
+#ifndef SD_P2_PRIORITYQUEUEMULTIQUEUE_H
+#define SD_P2_PRIORITYQUEUEMULTIQUEUE_H
+
+//Relaxed concurrent priority queue after Rihani, Sanders and Dementiev
+//The elements are spread over c*p binary heaps, each behind its own lock that is only ever tried, never waited for
+//Enqueue goes to a random heap, dequeue looks at the heads of two random heaps and takes the better one,
+//so threads rarely meet on a lock, and the removed element is among the smallest ones with high probability
+//The order is only roughly best-first; a RankErrorMeter can be attached to measure how roughly
+template <typename T>
+class PriorityQueueMultiQueue : public PriorityQueue<T> {
+private:
+    using Lanes = LockedLanes<MinHeap<Node<T>>>;
+    using Lane = typename Lanes::Lane;
+    static constexpr long long EMPTY = Lanes::EMPTY;
+
+    Lanes lanes;
+    std::atomic<int> size;
+    RankErrorMeter* meter;
+
+    static int laneCountFor(int threads, int c) {
+        if (c < 1) throw std::invalid_argument("At least one heap per thread is needed");
+        return c * std::max(1, threads);
+    }
+
+    int randomLane() const {
+        return static_cast<int>(ThreadRandom::next() % static_cast<uint32_t>(lanes.count()));
+    }
+
+public:
+    //c heaps per thread, for threads running at the same time
+    explicit PriorityQueueMultiQueue(int threads = static_cast<int>(std::thread::hardware_concurrency()), int c = 2)
+        : lanes(laneCountFor(threads, c)), size(0), meter(nullptr) {}
+
+    PriorityQueueMultiQueue(const PriorityQueueMultiQueue&) = delete;
+    PriorityQueueMultiQueue& operator=(const PriorityQueueMultiQueue&) = delete;
+
+    //Records every enqueued and dequeued priority in meter, nullptr stops recording
+    //It has to be attached while no other thread uses the queue
+    void attachRankMeter(RankErrorMeter* rankMeter) {
+        meter = rankMeter;
+    }
+
+    int heapCount() const {
+        return lanes.count();
+    }
+
+    void enqueue(T element, int priority) override {
+        if (meter) meter->inserted(priority);
+        size.fetch_add(1, std::memory_order_relaxed);
+        while (true) {
+            Lane& lane = lanes[randomLane()];
+            if (!lane.lock.try_lock()) continue;
+            lane.heap.insert(Node<T>(std::move(element), priority));
+            lane.updateTop();
+            lane.lock.unlock();
+            return;
+        }
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes one of the most urgent elements into element, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        while (true) {
+            int first = randomLane();
+            int second = randomLane();
+            long long firstTop = lanes.top(first);
+            long long secondTop = lanes.top(second);
+            Lane& lane = lanes[secondTop < firstTop ? second : first];
+            if (firstTop == EMPTY && secondTop == EMPTY) {
+                if (lanes.allEmpty()) return false;
+                continue;
+            }
+            if (!lane.lock.try_lock()) continue;
+            if (lane.heap.empty()) {
+                lane.lock.unlock();
+                continue;
+            }
+            Node<T> node = lane.heap.extractMin();
+            lane.updateTop();
+            lane.lock.unlock();
+            size.fetch_sub(1, std::memory_order_relaxed);
+            if (meter) meter->removed(node.priority);
+            element = std::move(node.element);
+            return true;
+        }
+    }
+
+    //Head of the heap with the smallest head, exact only while no other thread changes the queue
+    T peek() const override {
+        while (true) {
+            int best = lanes.best();
+            if (best == -1) {
+                if (lanes.allEmpty()) throw std::runtime_error("Queue is empty");
+                continue;
+            }
+            std::lock_guard<SpinLockSync> guard(lanes[best].lock);
+            if (!lanes[best].heap.empty()) return lanes[best].heap.min().element;
+        }
+    }
+
+    int peekPriority() const override {
+        while (true) {
+            int best = lanes.best();
+            if (best == -1) {
+                if (lanes.allEmpty()) throw std::runtime_error("Queue is empty");
+                continue;
+            }
+            std::lock_guard<SpinLockSync> guard(lanes[best].lock);
+            if (!lanes[best].heap.empty()) return lanes[best].heap.min().priority;
+        }
+    }
+
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        lanes.untilLocked([&](Lane& lane) {
+            for (int j = 0; j < lane.heap.size(); j++) {
+                if (lane.heap.get(j).element == element) {
+                    if (meter) {
+                        meter->erased(lane.heap.get(j).priority);
+                        meter->inserted(newPriority);
+                    }
+                    Node<T> node = lane.heap.get(j);
+                    node.priority = newPriority;
+                    lane.heap.replace(j, node);
+                    lane.updateTop();
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    bool isEmpty() const override {
+        return getSize() == 0;
+    }
+
+    //Locks one heap at a time, so it is a consistent picture only while no other thread changes the queue
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        lanes.untilLocked([&](Lane& lane) {
+            for (int j = 0; j < lane.heap.size(); j++) {
+                visit(lane.heap.get(j).element, lane.heap.get(j).priority);
+            }
+            return false;
+        });
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEMULTIQUEUE_H
@@ -0,0 +1,221 @@
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "NodePool.h"
+
+#ifndef SD_P2_PRIORITYQUEUEPAIRINGHEAP_H
+#define SD_P2_PRIORITYQUEUEPAIRINGHEAP_H
+
+template <typename T>
+struct PairingNode {
+    T element;
+    int priority;
+
+    PairingNode* child; //Leftmost child
+    PairingNode* next; //Right sibling
+    PairingNode* prev; //Left sibling, or the parent for a leftmost child
+
+    PairingNode(T element, int priority)
+            : element(element), priority(priority), child(nullptr), next(nullptr), prev(nullptr) {}
+};
+
+//Pairing heap with two-pass pairing on dequeue
+//Nodes come from a pool and push() returns a handle for constant time decrease of priority
+template <typename T>
+class PriorityQueuePairingHeap : public PriorityQueue<T> {
+public:
+    //Refers to the node holding an element, valid until the element leaves the queue
+    struct Handle {
+        PairingNode<T>* node;
+    };
+
+private:
+    NodePool<PairingNode<T>> pool;
+    PairingNode<T>* root;
+    int n;
+
+    //Makes the root with the greater priority the leftmost child of the other one
+    static PairingNode<T>* link(PairingNode<T>* first, PairingNode<T>* second) {
+        if (!first) return second;
+        if (!second) return first;
+        if (second->priority < first->priority) std::swap(first, second);
+        second->next = first->child;
+        if (first->child) first->child->prev = second;
+        second->prev = first;
+        first->child = second;
+        return first;
+    }
+
+    //Detaches the node together with its subtree from its siblings and parent
+    static void cut(PairingNode<T>* node) {
+        if (node->prev->child == node) node->prev->child = node->next;
+        else node->prev->next = node->next;
+        if (node->next) node->next->prev = node->prev;
+        node->next = nullptr;
+        node->prev = nullptr;
+    }
+
+    //Two-pass pairing – link neighbours left to right, then fold the results right to left
+    static PairingNode<T>* combineSiblings(PairingNode<T>* first) {
+        if (!first) return nullptr;
+        PairingNode<T>* paired = nullptr;
+        while (first) {
+            PairingNode<T>* a = first;
+            PairingNode<T>* b = a->next;
+            first = b ? b->next : nullptr;
+            a->next = a->prev = nullptr;
+            if (b) b->next = b->prev = nullptr;
+            PairingNode<T>* merged = link(a, b);
+            merged->next = paired; //Stack of pairs, rightmost on top
+            paired = merged;
+        }
+        PairingNode<T>* result = paired;
+        paired = paired->next;
+        result->next = nullptr;
+        while (paired) {
+            PairingNode<T>* nextPair = paired->next;
+            paired->next = nullptr;
+            result = link(result, paired);
+            paired = nextPair;
+        }
+        return result;
+    }
+
+    PairingNode<T>* findNode(const T& element) const {
+        std::vector<PairingNode<T>*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            PairingNode<T>* node = stack.back();
+            stack.pop_back();
+            if (node->element == element) return node;
+            for (PairingNode<T>* child = node->child; child; child = child->next) {
+                stack.push_back(child);
+            }
+        }
+        return nullptr;
+    }
+
+    void releaseAll() {
+        std::vector<PairingNode<T>*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            PairingNode<T>* node = stack.back();
+            stack.pop_back();
+            for (PairingNode<T>* child = node->child; child; child = child->next) {
+                stack.push_back(child);
+            }
+            pool.release(node);
+        }
+        root = nullptr;
+        n = 0;
+    }
+
+public:
+    PriorityQueuePairingHeap() : root(nullptr), n(0) {}
+
+    ~PriorityQueuePairingHeap() {
+        releaseAll();
+    }
+
+    //Inserts the element and returns a handle usable with modifyPriority
+    Handle push(T element, int priority) {
+        PairingNode<T>* node = pool.acquire(element, priority);
+        root = link(root, node);
+        n++;
+        return Handle{node};
+    }
+
+    void enqueue(T element, int priority) override {
+        push(element, priority);
+    }
+
+    T dequeue() override {
+        if (!root) throw std::runtime_error("Queue is empty");
+        PairingNode<T>* min = root;
+        root = combineSiblings(min->child);
+        T element = min->element;
+        pool.release(min);
+        n--;
+        return element;
+    }
+
+    T peek() const override {
+        if (!root) throw std::runtime_error("Queue is empty");
+        return root->element;
+    }
+
+    int peekPriority() const override {
+        if (!root) throw std::runtime_error("Queue is empty");
+        return root->priority;
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    //Decreasing cuts the subtree and links it with the root in O(1)
+    //Increasing cuts the node alone, pairs its children and links both back
+    void modifyPriority(Handle handle, int newPriority) {
+        PairingNode<T>* node = handle.node;
+        if (!node) throw std::invalid_argument("Invalid handle");
+        if (newPriority <= node->priority) {
+            node->priority = newPriority;
+            if (node != root) {
+                cut(node);
+                root = link(root, node);
+            }
+            return;
+        }
+
+        if (node == root) {
+            root = nullptr;
+        } else {
+            cut(node);
+        }
+        PairingNode<T>* children = combineSiblings(node->child);
+        node->child = nullptr;
+        node->priority = newPriority;
+        root = link(link(root, children), node);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        PairingNode<T>* node = findNode(element);
+        if (!node) return;
+        modifyPriority(Handle{node}, newPriority);
+    }
+
+    bool isEmpty() const override {
+        return root == nullptr;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        std::vector<PairingNode<T>*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            PairingNode<T>* node = stack.back();
+            stack.pop_back();
+            visit(node->element, node->priority);
+            for (PairingNode<T>* child = node->child; child; child = child->next) {
+                stack.push_back(child);
+            }
+        }
+    }
+
+    //Links the two roots in O(1), the nodes of other are adopted together with its pool blocks
+    void meld(PriorityQueue<T>&& other) override {
+        auto* same = dynamic_cast<PriorityQueuePairingHeap<T>*>(&other);
+        if (!same) {
+            PriorityQueue<T>::meld(std::move(other));
+            return;
+        }
+        if (same == this) return;
+        pool.absorb(same->pool);
+        root = link(root, same->root);
+        n += same->n;
+        same->root = nullptr;
+        same->n = 0;
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEPAIRINGHEAP_H
@@ -0,0 +1,133 @@
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "PriorityQueue.h"
+
+#ifndef SD_P2_PRIORITYQUEUERADIXHEAP_H
+#define SD_P2_PRIORITYQUEUERADIXHEAP_H
+
+template <typename T>
+struct RadixEntry {
+    T element;
+    uint32_t key;
+
+    RadixEntry(T element, uint32_t key) : element(element), key(key) {}
+};
+
+//Radix heap for monotone workloads – every enqueued priority must be at least the last dequeued one
+//An entry lives in the bucket given by the highest bit in which its key differs from the last extracted key
+template <typename T>
+class PriorityQueueRadixHeap : public PriorityQueue<T> {
+private:
+    static constexpr int BUCKETS = 33;
+
+    std::vector<RadixEntry<T>> buckets[BUCKETS];
+    uint32_t last; //Key of the last extracted element
+    int n;
+
+    //Maps a signed priority onto an unsigned key with the same ordering
+    static uint32_t toKey(int priority) {
+        return static_cast<uint32_t>(priority) ^ 0x80000000u;
+    }
+
+    int bucketOf(uint32_t key) const {
+        return key == last ? 0 : 32 - std::countl_zero(key ^ last);
+    }
+
+    int firstNonEmptyBucket() const {
+        for (int i = 0; i < BUCKETS; i++) {
+            if (!buckets[i].empty()) return i;
+        }
+        return -1;
+    }
+
+    //Finds the entry dequeue would return without redistributing any bucket
+    const RadixEntry<T>& minEntry() const {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        int i = firstNonEmptyBucket();
+        if (i == 0) return buckets[0].back();
+        const RadixEntry<T>* best = &buckets[i][0];
+        for (const RadixEntry<T>& entry : buckets[i]) {
+            if (entry.key < best->key) best = &entry;
+        }
+        return *best;
+    }
+
+    //Makes the minimal key the new last key and spreads the bucket holding it over the lower buckets
+    void pull() {
+        if (!buckets[0].empty()) return;
+        int i = firstNonEmptyBucket();
+        uint32_t minKey = buckets[i][0].key;
+        for (const RadixEntry<T>& entry : buckets[i]) {
+            if (entry.key < minKey) minKey = entry.key;
+        }
+        last = minKey;
+        std::vector<RadixEntry<T>> moved;
+        moved.swap(buckets[i]);
+        for (RadixEntry<T>& entry : moved) {
+            buckets[bucketOf(entry.key)].push_back(entry);
+        }
+    }
+
+public:
+    PriorityQueueRadixHeap() : last(toKey(INT32_MIN)), n(0) {}
+
+    void enqueue(T element, int priority) override {
+        uint32_t key = toKey(priority);
+        assert(key >= last && "Radix heap requires priorities not smaller than the last dequeued one");
+        buckets[bucketOf(key)].push_back(RadixEntry<T>(element, key));
+        n++;
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        pull();
+        T element = buckets[0].back().element;
+        buckets[0].pop_back();
+        n--;
+        return element;
+    }
+
+    T peek() const override {
+        return minEntry().element;
+    }
+
+    int peekPriority() const override {
+        return static_cast<int>(minEntry().key ^ 0x80000000u);
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    //The new priority has to respect monotonicity as well
+    void modifyPriority(T element, int newPriority) override {
+        for (auto& bucket : buckets) {
+            for (int i = 0; i < static_cast<int>(bucket.size()); i++) {
+                if (bucket[i].element == element) {
+                    bucket[i] = bucket.back();
+                    bucket.pop_back();
+                    n--;
+                    enqueue(element, newPriority);
+                    return;
+                }
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (const std::vector<RadixEntry<T>>& bucket : buckets) {
+            for (const RadixEntry<T>& entry : bucket) {
+                visit(entry.element, static_cast<int>(entry.key ^ 0x80000000u));
+            }
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUERADIXHEAP_H
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "LoserTree.h"
+
+#ifndef SD_P2_PRIORITYQUEUESEQUENCEHEAP_H
+#define SD_P2_PRIORITYQUEUESEQUENCEHEAP_H
+
+template <typename T>
+struct SequenceEntry {
+    int priority;
+    T element;
+};
+
+//Sequence heap after Sanders – new elements go to a small insertion heap, a full insertion heap becomes
+//a sorted run, and runs are collected in groups where MergeArity runs are merged into one run of the next group
+//The smallest elements of all runs are merged into a deletion buffer, so apart from the two small heaps
+//all work is sequential streaming through sorted arrays
+//Unlike the original, the deletion buffer is refilled by one loser tree over the runs of all groups
+template <typename T, int InsertionCapacity = 256, int MergeArity = 64>
+class PriorityQueueSequenceHeap : public PriorityQueue<T> {
+    static_assert(InsertionCapacity > 0, "Insertion heap capacity must be positive");
+    static_assert(MergeArity > 1, "At least two runs have to be merged at once");
+
+private:
+    using Entry = SequenceEntry<T>;
+
+    struct Run {
+        std::vector<Entry> items;
+        size_t head = 0; //Items before the head have already been merged away
+
+        bool exhausted() const {
+            return head == items.size();
+        }
+    };
+
+    MinHeap<Node<T>> insertionHeap;
+    std::vector<Entry> buffer; //Sorted, never greater than anything left in the runs
+    size_t bufferHead;
+    std::vector<std::vector<Run>> groups;
+    LoserTree<int> tree;
+    int n;
+
+    //Streams the smallest items of the runs into out until it holds limit items or the runs are exhausted
+    void mergeRuns(const std::vector<Run*>& runs, size_t limit, std::vector<Entry>& out) {
+        std::vector<int> heads(runs.size());
+        std::vector<bool> active(runs.size());
+        for (size_t i = 0; i < runs.size(); i++) {
+            active[i] = !runs[i]->exhausted();
+            if (active[i]) heads[i] = runs[i]->items[runs[i]->head].priority;
+        }
+        tree.build(heads, active);
+        int winner;
+        while (out.size() < limit && (winner = tree.winner()) >= 0) {
+            Run* run = runs[winner];
+            out.push_back(std::move(run->items[run->head]));
+            run->head++;
+            if (run->exhausted()) tree.exhaust();
+            else tree.replace(run->items[run->head].priority);
+        }
+    }
+
+    //Adds a sorted run to the group, a group that gets too many runs is merged into one run of the next group
+    void addRun(std::vector<Entry>&& items, size_t group) {
+        if (items.empty()) return;
+        if (group == groups.size()) groups.emplace_back();
+        groups[group].push_back(Run{std::move(items), 0});
+        if (static_cast<int>(groups[group].size()) <= MergeArity) return;
+
+        std::vector<Run*> runs;
+        size_t total = 0;
+        for (Run& run : groups[group]) {
+            runs.push_back(&run);
+            total += run.items.size() - run.head;
+        }
+        std::vector<Entry> merged;
+        merged.reserve(total);
+        mergeRuns(runs, total, merged);
+        groups[group].clear();
+        addRun(std::move(merged), group + 1);
+    }
+
+    //Refills the deletion buffer from the runs and forgets the runs that got exhausted
+    void refill() {
+        buffer.clear();
+        bufferHead = 0;
+        std::vector<Run*> runs;
+        for (std::vector<Run>& group : groups) {
+            for (Run& run : group) {
+                runs.push_back(&run);
+            }
+        }
+        if (runs.empty()) return;
+        mergeRuns(runs, InsertionCapacity, buffer);
+        for (std::vector<Run>& group : groups) {
+            size_t kept = 0;
+            for (size_t i = 0; i < group.size(); i++) {
+                if (!group[i].exhausted()) {
+                    if (kept != i) group[kept] = std::move(group[i]);
+                    kept++;
+                }
+            }
+            group.resize(kept);
+        }
+    }
+
+    //Turns the insertion heap into a sorted run
+    //It is merged with the deletion buffer first, so the buffer keeps the smallest items of all runs
+    void flush() {
+        std::vector<Entry> sorted;
+        sorted.reserve(insertionHeap.size());
+        while (!insertionHeap.empty()) {
+            Node<T> node = insertionHeap.extractMin();
+            sorted.push_back(Entry{node.priority, node.element});
+        }
+
+        size_t keep = buffer.size() - bufferHead;
+        std::vector<Entry> merged;
+        merged.reserve(keep + sorted.size());
+        size_t i = bufferHead;
+        size_t j = 0;
+        while (i < buffer.size() && j < sorted.size()) {
+            if (sorted[j].priority < buffer[i].priority) merged.push_back(std::move(sorted[j++]));
+            else merged.push_back(std::move(buffer[i++]));
+        }
+        while (i < buffer.size()) merged.push_back(std::move(buffer[i++]));
+        while (j < sorted.size()) merged.push_back(std::move(sorted[j++]));
+
+        buffer.assign(std::make_move_iterator(merged.begin()), std::make_move_iterator(merged.begin() + keep));
+        bufferHead = 0;
+        merged.erase(merged.begin(), merged.begin() + keep);
+        addRun(std::move(merged), 0);
+        if (buffer.empty()) refill();
+    }
+
+    bool bufferEmpty() const {
+        return bufferHead == buffer.size();
+    }
+
+    //Checks whether the next element to leave is the head of the deletion buffer
+    bool minInBuffer() const {
+        if (bufferEmpty()) return false;
+        return insertionHeap.empty() || buffer[bufferHead].priority <= insertionHeap.min().priority;
+    }
+
+    //Removes the element wherever it is, returns whether it was found
+    bool removeElement(const T& element) {
+        for (int i = 0; i < insertionHeap.size(); i++) {
+            if (insertionHeap.get(i).element == element) {
+                insertionHeap.remove(i);
+                return true;
+            }
+        }
+        for (size_t i = bufferHead; i < buffer.size(); i++) {
+            if (buffer[i].element == element) {
+                buffer.erase(buffer.begin() + i);
+                if (bufferEmpty()) refill();
+                return true;
+            }
+        }
+        for (std::vector<Run>& group : groups) {
+            for (size_t r = 0; r < group.size(); r++) {
+                Run& run = group[r];
+                for (size_t i = run.head; i < run.items.size(); i++) {
+                    if (run.items[i].element == element) {
+                        run.items.erase(run.items.begin() + i);
+                        if (run.exhausted()) group.erase(group.begin() + r);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+public:
+    PriorityQueueSequenceHeap() : insertionHeap(InsertionCapacity), bufferHead(0), n(0) {}
+
+    void enqueue(T element, int priority) override {
+        if (insertionHeap.size() == InsertionCapacity) flush();
+        insertionHeap.insert(Node<T>(element, priority));
+        n++;
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        n--;
+        if (!minInBuffer()) return insertionHeap.extractMin().element;
+        T element = std::move(buffer[bufferHead].element);
+        bufferHead++;
+        if (bufferEmpty()) refill();
+        return element;
+    }
+
+    T peek() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        if (minInBuffer()) return buffer[bufferHead].element;
+        return insertionHeap.min().element;
+    }
+
+    int peekPriority() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        if (minInBuffer()) return buffer[bufferHead].priority;
+        return insertionHeap.min().priority;
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        if (!removeElement(element)) return;
+        n--;
+        enqueue(element, newPriority);
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (int i = 0; i < insertionHeap.size(); i++) {
+            visit(insertionHeap.get(i).element, insertionHeap.get(i).priority);
+        }
+        for (size_t i = bufferHead; i < buffer.size(); i++) {
+            visit(buffer[i].element, buffer[i].priority);
+        }
+        for (const std::vector<Run>& group : groups) {
+            for (const Run& run : group) {
+                for (size_t i = run.head; i < run.items.size(); i++) {
+                    visit(run.items[i].element, run.items[i].priority);
+                }
+            }
+        }
+    }
+
+protected:
+    //Without runs the sorted batch becomes a single run, otherwise the deletion buffer would have to be merged with it
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        if (!bufferEmpty()) {
+            PriorityQueue<T>::loadEntries(entries);
+            return;
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const SnapshotEntry<T>& a, const SnapshotEntry<T>& b) {
+            return a.priority < b.priority;
+        });
+        std::vector<Entry> items;
+        items.reserve(entries.size());
+        for (SnapshotEntry<T>& entry : entries) {
+            items.push_back(Entry{entry.priority, std::move(entry.element)});
+        }
+        n += static_cast<int>(items.size());
+        addRun(std::move(items), groups.size());
+        refill();
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUESEQUENCEHEAP_H
@@ -0,0 +1,285 @@
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "PriorityQueue.h"
+#include "DynamicArray.h"
+#include "HierarchicalBitmap.h"
+
+#ifndef SD_P2_PRIORITYQUEUETIMINGWHEEL_H
+#define SD_P2_PRIORITYQUEUETIMINGWHEEL_H
+
+template <typename T>
+struct TimerEntry {
+    T element;
+    uint32_t deadline;
+    int prev;
+    int next;
+    int level;
+    int slot;
+    unsigned generation; //Bumped whenever the entry is released so stale handles are detected
+    bool active;
+
+    TimerEntry() : element(T()), deadline(0), prev(-1), next(-1), level(0), slot(0), generation(0), active(false) {}
+};
+
+//Hierarchical timing wheel – priorities are absolute, non-negative deadlines
+//Level l has 256 slots, each covering 256^l ticks, and a timer sits on the highest level in which
+//its deadline differs from the wheel's current time, so insert and cancel are O(1)
+//Deadlines earlier than the current time fire at the current time
+template <typename T>
+class PriorityQueueTimingWheel : public PriorityQueue<T> {
+public:
+    struct Handle {
+        int index;
+        unsigned generation;
+    };
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+
+    std::vector<TimerEntry<T>> entries;
+    std::vector<int> freeEntries;
+    int slotHead[LEVELS][SLOTS];
+    int slotTail[LEVELS][SLOTS];
+    HierarchicalBitmap occupied[LEVELS] = {
+            HierarchicalBitmap(SLOTS), HierarchicalBitmap(SLOTS), HierarchicalBitmap(SLOTS), HierarchicalBitmap(SLOTS)};
+    uint32_t current; //Time of the wheel, never past the earliest pending deadline
+    int n;
+
+    int slotOfCurrent(int level) const {
+        return static_cast<int>((current >> (SLOT_BITS * level)) & (SLOTS - 1));
+    }
+
+    //Files the entry under the level and slot derived from its deadline
+    void place(int index) {
+        TimerEntry<T>& entry = entries[index];
+        int level = 0;
+        int slot = slotOfCurrent(0);
+        if (entry.deadline > current) {
+            level = (31 - std::countl_zero(entry.deadline ^ current)) / SLOT_BITS;
+            slot = static_cast<int>((entry.deadline >> (SLOT_BITS * level)) & (SLOTS - 1));
+        }
+        entry.level = level;
+        entry.slot = slot;
+        entry.prev = slotTail[level][slot];
+        entry.next = -1;
+        if (slotTail[level][slot] == -1) {
+            slotHead[level][slot] = index;
+            occupied[level].set(slot);
+        } else {
+            entries[slotTail[level][slot]].next = index;
+        }
+        slotTail[level][slot] = index;
+    }
+
+    void unlink(int index) {
+        TimerEntry<T>& entry = entries[index];
+        int level = entry.level;
+        int slot = entry.slot;
+        if (entry.prev == -1) slotHead[level][slot] = entry.next;
+        else entries[entry.prev].next = entry.next;
+        if (entry.next == -1) slotTail[level][slot] = entry.prev;
+        else entries[entry.next].prev = entry.prev;
+        if (slotHead[level][slot] == -1) {
+            occupied[level].reset(slot);
+        }
+    }
+
+    void release(int index) {
+        entries[index].active = false;
+        entries[index].generation++;
+        entries[index].element = T();
+        freeEntries.push_back(index);
+        n--;
+    }
+
+    //Finds the level 0 slot holding the earliest timers, cascading higher slots down as needed
+    //The wheel time is never moved past the limit; returns -1 if no timer is due by then
+    int nextSlot(uint32_t limit) {
+        while (n > 0) {
+            int slot = occupied[0].findNext(slotOfCurrent(0));
+            if (slot >= 0) {
+                uint32_t deadline = (current & ~static_cast<uint32_t>(SLOTS - 1)) | static_cast<uint32_t>(slot);
+                if (deadline > limit) return -1;
+                if (deadline > current) current = deadline;
+                return slot;
+            }
+
+            int level = 1;
+            for (; level < LEVELS; level++) {
+                slot = occupied[level].findNext(slotOfCurrent(level) + 1);
+                if (slot >= 0) break;
+            }
+            if (level == LEVELS) return -1;
+
+            //Jump to the beginning of the found slot's range and redistribute its timers
+            uint64_t span = uint64_t(1) << (SLOT_BITS * (level + 1));
+            uint64_t start = (current & ~(span - 1)) | (static_cast<uint64_t>(slot) << (SLOT_BITS * level));
+            if (start > limit) return -1;
+            current = static_cast<uint32_t>(start);
+
+            int index = slotHead[level][slot];
+            slotHead[level][slot] = -1;
+            slotTail[level][slot] = -1;
+            occupied[level].reset(slot);
+            while (index != -1) {
+                int next = entries[index].next;
+                place(index);
+                index = next;
+            }
+        }
+        return -1;
+    }
+
+    //Finds the entry dequeue would fire next without cascading any slot
+    int peekIndex() const {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        int slot = occupied[0].findNext(slotOfCurrent(0));
+        if (slot >= 0) return slotHead[0][slot];
+        for (int level = 1; level < LEVELS; level++) {
+            slot = occupied[level].findNext(slotOfCurrent(level) + 1);
+            if (slot < 0) continue;
+            int best = slotHead[level][slot];
+            for (int index = entries[best].next; index != -1; index = entries[index].next) {
+                if (entries[index].deadline < entries[best].deadline) best = index;
+            }
+            return best;
+        }
+        throw std::runtime_error("Queue is empty");
+    }
+
+    void checkDeadline(int deadline) const {
+        if (deadline < 0) throw std::out_of_range("Deadline cannot be negative");
+    }
+
+    int checkHandle(Handle handle) const {
+        if (handle.index < 0 || handle.index >= static_cast<int>(entries.size())) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        return handle.index;
+    }
+
+public:
+    explicit PriorityQueueTimingWheel(int now = 0) : current(static_cast<uint32_t>(now)), n(0) {
+        checkDeadline(now);
+        for (int level = 0; level < LEVELS; level++) {
+            for (int slot = 0; slot < SLOTS; slot++) {
+                slotHead[level][slot] = -1;
+                slotTail[level][slot] = -1;
+            }
+        }
+    }
+
+    //Registers a timer and returns a handle for cancel
+    Handle schedule(T element, int deadline) {
+        checkDeadline(deadline);
+        int index;
+        if (!freeEntries.empty()) {
+            index = freeEntries.back();
+            freeEntries.pop_back();
+        } else {
+            index = static_cast<int>(entries.size());
+            entries.emplace_back();
+        }
+        TimerEntry<T>& entry = entries[index];
+        entry.element = element;
+        entry.deadline = static_cast<uint32_t>(deadline);
+        entry.active = true;
+        place(index);
+        n++;
+        return Handle{index, entry.generation};
+    }
+
+    //Removes a pending timer, returns false if it has already fired or been cancelled
+    bool cancel(Handle handle) {
+        int index = checkHandle(handle);
+        if (!entries[index].active || entries[index].generation != handle.generation) return false;
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    //Moves the wheel time to now and appends every expired element to out in deadline order
+    void advanceTo(int now, DynamicArray<T>& out) {
+        checkDeadline(now);
+        uint32_t limit = static_cast<uint32_t>(now);
+        int slot;
+        while ((slot = nextSlot(limit)) >= 0) {
+            int index = slotHead[0][slot];
+            while (index != -1) {
+                int next = entries[index].next;
+                out.pushBack(entries[index].element);
+                unlink(index);
+                release(index);
+                index = next;
+            }
+        }
+        if (limit > current) current = limit;
+    }
+
+    int now() const {
+        return static_cast<int>(current);
+    }
+
+    void enqueue(T element, int priority) override {
+        schedule(element, priority);
+    }
+
+    //Fires the earliest timer, moving the wheel time to its deadline
+    T dequeue() override {
+        int slot = nextSlot(UINT32_MAX);
+        if (slot < 0) throw std::runtime_error("Queue is empty");
+        int index = slotHead[0][slot];
+        T element = entries[index].element;
+        unlink(index);
+        release(index);
+        return element;
+    }
+
+    T peek() const override {
+        return entries[peekIndex()].element;
+    }
+
+    int peekPriority() const override {
+        return static_cast<int>(entries[peekIndex()].deadline);
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    void modifyPriority(Handle handle, int newPriority) {
+        checkDeadline(newPriority);
+        int index = checkHandle(handle);
+        if (!entries[index].active || entries[index].generation != handle.generation) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        unlink(index);
+        entries[index].deadline = static_cast<uint32_t>(newPriority);
+        place(index);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        for (int i = 0; i < static_cast<int>(entries.size()); i++) {
+            if (entries[i].active && entries[i].element == element) {
+                modifyPriority(Handle{i, entries[i].generation}, newPriority);
+                return;
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (const TimerEntry<T>& entry : entries) {
+            if (entry.active) visit(entry.element, static_cast<int>(entry.deadline));
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUETIMINGWHEEL_H
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <stdexcept>
+#include "PriorityQueue.h"
+
+#ifndef SD_P2_PRIORITYQUEUEUNROLLEDLINKEDLIST_H
+#define SD_P2_PRIORITYQUEUEUNROLLEDLINKEDLIST_H
+
+//Node of the unrolled list – a small sorted chunk of (priority, element) pairs
+//Priorities are kept in their own array so a whole node can be scanned without touching the elements
+template <typename T, int Capacity>
+struct UnrolledNode {
+    int priorities[Capacity];
+    T elements[Capacity];
+    int begin; //Index of the first occupied slot
+    int end; //Index one past the last occupied slot
+    UnrolledNode* next;
+
+    UnrolledNode() : begin(0), end(0), next(nullptr) {}
+
+    int count() const {
+        return end - begin;
+    }
+};
+
+template <typename T, int NodeCapacity = 16>
+class PriorityQueueUnrolledLinkedList : public PriorityQueue<T> {
+    static_assert(NodeCapacity >= 4, "Node capacity must be at least 4");
+
+private:
+    using Chunk = UnrolledNode<T, NodeCapacity>;
+
+    Chunk* head;
+    int n;
+
+    //Returns the index at which an element with the given priority goes, after all equal priorities
+    //Counting instead of searching keeps the loop branch-free so the compiler can vectorize it
+    static int upperBound(const Chunk* node, int priority) {
+        int position = node->begin;
+        for (int i = node->begin; i < node->end; i++) {
+            position += node->priorities[i] <= priority;
+        }
+        return position;
+    }
+
+    //Moves the upper half of a full node into a new node linked right after it
+    void split(Chunk* node) {
+        Chunk* sibling = new Chunk();
+        int middle = node->begin + node->count() / 2;
+        for (int i = middle; i < node->end; i++) {
+            sibling->priorities[sibling->end] = node->priorities[i];
+            sibling->elements[sibling->end] = node->elements[i];
+            sibling->end++;
+        }
+        node->end = middle;
+        sibling->next = node->next;
+        node->next = sibling;
+    }
+
+    //Moves the occupied slots of the node to the beginning of its arrays
+    static void compact(Chunk* node) {
+        if (node->begin == 0) return;
+        int count = node->count();
+        for (int i = 0; i < count; i++) {
+            node->priorities[i] = node->priorities[node->begin + i];
+            node->elements[i] = node->elements[node->begin + i];
+        }
+        node->begin = 0;
+        node->end = count;
+    }
+
+    //Inserts the pair at the given position of a node that is known to have a free slot
+    static void insertAt(Chunk* node, int position, const T& element, int priority) {
+        if (node->end < NodeCapacity) {
+            for (int i = node->end; i > position; i--) {
+                node->priorities[i] = node->priorities[i - 1];
+                node->elements[i] = node->elements[i - 1];
+            }
+            node->end++;
+        } else {
+            for (int i = node->begin; i < position; i++) {
+                node->priorities[i - 1] = node->priorities[i];
+                node->elements[i - 1] = node->elements[i];
+            }
+            node->begin--;
+            position--;
+        }
+        node->priorities[position] = priority;
+        node->elements[position] = element;
+    }
+
+    //Removes the slot at the given index and merges the node with its successor if it got sparse
+    void removeAt(Chunk* prev, Chunk* node, int index) {
+        for (int i = index; i < node->end - 1; i++) {
+            node->priorities[i] = node->priorities[i + 1];
+            node->elements[i] = node->elements[i + 1];
+        }
+        node->end--;
+        n--;
+
+        if (node->count() == 0) {
+            if (prev) prev->next = node->next;
+            else head = node->next;
+            delete node;
+            return;
+        }
+
+        Chunk* next = node->next;
+        if (next && node->count() < NodeCapacity / 4 && node->count() + next->count() <= NodeCapacity) {
+            compact(node);
+            for (int i = next->begin; i < next->end; i++) {
+                node->priorities[node->end] = next->priorities[i];
+                node->elements[node->end] = next->elements[i];
+                node->end++;
+            }
+            node->next = next->next;
+            delete next;
+        }
+    }
+
+public:
+    PriorityQueueUnrolledLinkedList() : head(nullptr), n(0) {}
+
+    ~PriorityQueueUnrolledLinkedList() {
+        while (head) {
+            Chunk* temp = head;
+            head = head->next;
+            delete temp;
+        }
+    }
+
+    //Skips whole nodes by their first priority, then places the pair inside the chosen node
+    void enqueue(T element, int priority) override {
+        if (!head) {
+            head = new Chunk();
+        }
+        Chunk* node = head;
+        while (node->next && node->next->priorities[node->next->begin] <= priority) {
+            node = node->next;
+        }
+
+        int position = upperBound(node, priority);
+        if (node->count() == NodeCapacity) {
+            split(node);
+            if (position > node->end) {
+                position -= node->end - node->next->begin;
+                node = node->next;
+            }
+        }
+        insertAt(node, position, element, priority);
+        n++;
+    }
+
+    T dequeue() override {
+        if (!head) throw std::runtime_error("Queue is empty");
+        T element = head->elements[head->begin];
+        head->begin++;
+        if (head->count() == 0) {
+            Chunk* temp = head;
+            head = head->next;
+            delete temp;
+        }
+        n--;
+        return element;
+    }
+
+    T peek() const override {
+        if (!head) throw std::runtime_error("Queue is empty");
+        return head->elements[head->begin];
+    }
+
+    int peekPriority() const override {
+        if (!head) throw std::runtime_error("Queue is empty");
+        return head->priorities[head->begin];
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        Chunk* prev = nullptr;
+        for (Chunk* node = head; node; prev = node, node = node->next) {
+            for (int i = node->begin; i < node->end; i++) {
+                if (node->elements[i] == element) {
+                    removeAt(prev, node, i);
+                    enqueue(element, newPriority);
+                    return;
+                }
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return head == nullptr;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (Chunk* node = head; node; node = node->next) {
+            for (int i = node->begin; i < node->end; i++) {
+                visit(node->elements[i], node->priorities[i]);
+            }
+        }
+    }
+
+protected:
+    //An empty list is built from the sorted batch directly, filling every node to three quarters
+    void loadEntries(std::vector<SnapshotEntry<T>>& entries) override {
+        if (head) {
+            PriorityQueue<T>::loadEntries(entries);
+            return;
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const SnapshotEntry<T>& a, const SnapshotEntry<T>& b) {
+            return a.priority < b.priority;
+        });
+        int fill = NodeCapacity * 3 / 4;
+        Chunk** tail = &head;
+        Chunk* node = nullptr;
+        for (SnapshotEntry<T>& entry : entries) {
+            if (!node || node->end == fill) {
+                node = new Chunk();
+                *tail = node;
+                tail = &node->next;
+            }
+            node->priorities[node->end] = entry.priority;
+            node->elements[node->end] = entry.element;
+            node->end++;
+        }
+        n = static_cast<int>(entries.size());
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEUNROLLEDLINKEDLIST_H
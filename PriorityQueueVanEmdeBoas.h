@@ -0,0 +1,141 @@
+#include <stdexcept>
+#include <vector>
+#include "PriorityQueue.h"
+#include "PriorityQueueBucket.h"
+#include "VanEmdeBoasTree.h"
+
+#ifndef SD_P2_PRIORITYQUEUEVANEMDEBOAS_H
+#define SD_P2_PRIORITYQUEUEVANEMDEBOAS_H
+
+//Integer priority queue for priorities in [0, 2^20)
+//Every priority owns a FIFO list of entries and a van Emde Boas tree holds the priorities with a non-empty list,
+//so the minimum is read in O(1) and a priority enters or leaves the tree in O(log log U)
+template <typename T>
+class PriorityQueueVanEmdeBoas : public PriorityQueue<T> {
+public:
+    static constexpr int PRIORITY_BITS = 20;
+    static constexpr int MAX_PRIORITY = (1 << PRIORITY_BITS) - 1;
+
+private:
+    std::vector<BucketEntry<T>> entries;
+    std::vector<int> freeEntries;
+    std::vector<int> listHead;
+    std::vector<int> listTail;
+    VanEmdeBoasTree<PRIORITY_BITS> keys;
+    int n;
+
+    void checkPriority(int priority) const {
+        if (priority < 0 || priority > MAX_PRIORITY) {
+            throw std::out_of_range("Priority out of range");
+        }
+    }
+
+    //Appends the entry to the list of its priority, the priority joins the tree with its first entry
+    void link(int index) {
+        BucketEntry<T>& entry = entries[index];
+        int key = entry.priority;
+        entry.prev = listTail[key];
+        entry.next = -1;
+        if (listTail[key] == -1) {
+            listHead[key] = index;
+            keys.insert(key);
+        } else {
+            entries[listTail[key]].next = index;
+        }
+        listTail[key] = index;
+    }
+
+    //Detaches the entry from its list, the priority leaves the tree with its last entry
+    void unlink(int index) {
+        BucketEntry<T>& entry = entries[index];
+        int key = entry.priority;
+        if (entry.prev == -1) listHead[key] = entry.next;
+        else entries[entry.prev].next = entry.next;
+        if (entry.next == -1) listTail[key] = entry.prev;
+        else entries[entry.next].prev = entry.prev;
+        if (listHead[key] == -1) {
+            keys.remove(key);
+        }
+    }
+
+    void release(int index) {
+        entries[index].active = false;
+        entries[index].element = T();
+        freeEntries.push_back(index);
+        n--;
+    }
+
+public:
+    PriorityQueueVanEmdeBoas() : listHead(MAX_PRIORITY + 1, -1), listTail(MAX_PRIORITY + 1, -1), n(0) {}
+
+    void enqueue(T element, int priority) override {
+        checkPriority(priority);
+        int index;
+        if (!freeEntries.empty()) {
+            index = freeEntries.back();
+            freeEntries.pop_back();
+        } else {
+            index = static_cast<int>(entries.size());
+            entries.emplace_back();
+        }
+        BucketEntry<T>& entry = entries[index];
+        entry.element = element;
+        entry.priority = priority;
+        entry.active = true;
+        link(index);
+        n++;
+    }
+
+    T dequeue() override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        int index = listHead[keys.min()];
+        T element = entries[index].element;
+        unlink(index);
+        release(index);
+        return element;
+    }
+
+    T peek() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return entries[listHead[keys.min()]].element;
+    }
+
+    int peekPriority() const override {
+        if (n == 0) throw std::runtime_error("Queue is empty");
+        return keys.min();
+    }
+
+    //Smallest priority in the queue greater than the given one, or -1 if there is none
+    int nextPriority(int priority) const {
+        checkPriority(priority);
+        return keys.successor(priority);
+    }
+
+    int getSize() const override {
+        return n;
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        checkPriority(newPriority);
+        for (int i = 0; i < static_cast<int>(entries.size()); i++) {
+            if (entries[i].active && entries[i].element == element) {
+                unlink(i);
+                entries[i].priority = newPriority;
+                link(i);
+                return;
+            }
+        }
+    }
+
+    bool isEmpty() const override {
+        return n == 0;
+    }
+
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        for (const BucketEntry<T>& entry : entries) {
+            if (entry.active) visit(entry.element, entry.priority);
+        }
+    }
+};
+
+#endif //SD_P2_PRIORITYQUEUEVANEMDEBOAS_H
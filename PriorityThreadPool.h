@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "ConcurrentSync.h"
+#include "EventCount.h"
+
+#ifndef SD_P2_PRIORITYTHREADPOOL_H
+#define SD_P2_PRIORITYTHREADPOOL_H
+
+//Task waiting in a PriorityThreadPool, shared by the queue that holds it and the handle of the submitter
+class PoolJob {
+public:
+    enum State {
+        Pending,
+        Running,
+        Cancelled
+    };
+
+    virtual ~PoolJob() = default;
+
+    //Runs the task unless it was cancelled first
+    void execute() {
+        int expected = Pending;
+        if (state.compare_exchange_strong(expected, Running, std::memory_order_acq_rel)) run();
+    }
+
+    //Returns true if the task will never run
+    bool cancel() {
+        int expected = Pending;
+        if (!state.compare_exchange_strong(expected, Cancelled, std::memory_order_acq_rel)) return expected == Cancelled;
+        abandon();
+        return true;
+    }
+
+    bool isCancelled() const {
+        return state.load(std::memory_order_acquire) == Cancelled;
+    }
+
+protected:
+    virtual void run() = 0;
+    virtual void abandon() = 0;
+
+private:
+    std::atomic<int> state{Pending};
+};
+
+//Task with its function and the promise of its result
+template <typename R, typename F>
+class PoolTaskJob : public PoolJob {
+public:
+    explicit PoolTaskJob(F function) : function(std::move(function)) {}
+
+    std::future<R> future() {
+        return promise.get_future();
+    }
+
+protected:
+    void run() override {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                function();
+                promise.set_value();
+            } else {
+                promise.set_value(function());
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    void abandon() override {
+        promise.set_exception(std::make_exception_ptr(std::runtime_error("Task was cancelled")));
+    }
+
+private:
+    F function;
+    std::promise<R> promise;
+};
+
+//What submit returns: the future of the result and a way to cancel the task before it starts
+template <typename R>
+class TaskHandle {
+public:
+    TaskHandle(std::shared_ptr<PoolJob> job, std::future<R> result) : job(std::move(job)), result(std::move(result)) {}
+
+    //Waits for the result, rethrows what the task threw, or throws if the task was cancelled
+    R get() {
+        return result.get();
+    }
+
+    void wait() const {
+        result.wait();
+    }
+
+    //Returns true if the task will never run, false if it is already running or done
+    bool cancel() {
+        return job->cancel();
+    }
+
+    bool isCancelled() const {
+        return job->isCancelled();
+    }
+
+private:
+    std::shared_ptr<PoolJob> job;
+    std::future<R> result;
+};
+
+//Thread pool running tasks by priority, smaller priorities first
+//Every worker has its own LocalQueue, any backend of this repo holding the jobs, behind its own lock
+//Tasks submitted by a worker go to its own queue, others go round robin over the workers
+//A worker whose queue runs empty steals up to half of the queue with the most urgent head, at most STEAL_BATCH
+//jobs, and sleeps on an EventCount once all queues are empty, so an idle pool costs nothing
+//The order is exact within a queue and only approximately best-first across the pool
+//Cancelled jobs stay in their queue and are dropped when a worker takes them
+template <typename LocalQueue = PriorityQueueMinHeap<std::shared_ptr<PoolJob>>>
+class PriorityThreadPool {
+    static_assert(std::is_same_v<typename LocalQueue::value_type, std::shared_ptr<PoolJob>>,
+                  "The local queue has to hold std::shared_ptr<PoolJob>");
+
+private:
+    using Workers = LockedLanes<LocalQueue>;
+    using Worker = typename Workers::Lane;
+    static constexpr int STEAL_BATCH = 32;
+
+    Workers workers;
+    std::vector<std::thread> runners;
+    std::atomic<int> queued;
+    std::atomic<unsigned> nextWorker; //Round robin counter, unsigned so that it wraps without turning negative
+    std::atomic<long long> stealCount;
+    std::atomic<bool> stopping;
+    EventCount idle;
+
+    struct WorkerIdentity {
+        const PriorityThreadPool* pool = nullptr;
+        int index = -1;
+    };
+
+    static WorkerIdentity& identity() {
+        thread_local WorkerIdentity current;
+        return current;
+    }
+
+    //Index of the calling thread among the workers of this pool, or -1 in other threads
+    int currentWorker() const {
+        const WorkerIdentity& current = identity();
+        return current.pool == this ? current.index : -1;
+    }
+
+    void push(int index, std::shared_ptr<PoolJob> job, int priority) {
+        Worker& worker = workers[index];
+        {
+            std::lock_guard<SpinLockSync> guard(worker.lock);
+            worker.heap.enqueue(std::move(job), priority);
+            worker.updateTop();
+        }
+        queued.fetch_add(1, std::memory_order_relaxed);
+        idle.notify(1);
+    }
+
+    bool pop(Worker& worker, std::shared_ptr<PoolJob>& job) {
+        std::lock_guard<SpinLockSync> guard(worker.lock);
+        if (worker.heap.isEmpty()) return false;
+        job = worker.heap.dequeue();
+        worker.updateTop();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //Moves the most urgent jobs of the worker with the most urgent head into own, the two locks are never held together
+    bool steal(int own) {
+        int victim = workers.best(own);
+        if (victim == -1) return false;
+        std::vector<SnapshotEntry<std::shared_ptr<PoolJob>>> batch;
+        {
+            std::lock_guard<SpinLockSync> guard(workers[victim].lock);
+            LocalQueue& queue = workers[victim].heap;
+            int take = std::min(STEAL_BATCH, std::max(1, queue.getSize() / 2));
+            for (int i = 0; i < take && !queue.isEmpty(); i++) {
+                int priority = queue.peekPriority();
+                batch.push_back(SnapshotEntry<std::shared_ptr<PoolJob>>{priority, queue.dequeue()});
+            }
+            workers[victim].updateTop();
+        }
+        if (batch.empty()) return false;
+        std::lock_guard<SpinLockSync> guard(workers[own].lock);
+        workers[own].heap.enqueueBulk(batch);
+        workers[own].updateTop();
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void work(int index) {
+        identity() = WorkerIdentity{this, index};
+        Worker& own = workers[index];
+        std::shared_ptr<PoolJob> job;
+        while (true) {
+            if (pop(own, job) || (steal(index) && pop(own, job))) {
+                job->execute();
+                job.reset();
+                continue;
+            }
+            uint32_t key = idle.prepareWait();
+            if (queued.load(std::memory_order_relaxed) > 0) {
+                idle.cancelWait();
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire)) {
+                idle.cancelWait();
+                return;
+            }
+            idle.wait(key);
+        }
+    }
+
+public:
+    explicit PriorityThreadPool(int threads = static_cast<int>(std::thread::hardware_concurrency()))
+        : workers(std::max(1, threads)), queued(0), nextWorker(0), stealCount(0), stopping(false) {
+        for (int i = 0; i < workers.count(); i++) {
+            runners.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    //Runs every task that was submitted and not cancelled, then stops the workers
+    //No thread may submit anymore once the destructor has started
+    ~PriorityThreadPool() {
+        stopping.store(true, std::memory_order_release);
+        idle.notify(workers.count());
+        for (std::thread& runner : runners) {
+            runner.join();
+        }
+    }
+
+    PriorityThreadPool(const PriorityThreadPool&) = delete;
+    PriorityThreadPool& operator=(const PriorityThreadPool&) = delete;
+
+    int threadCount() const {
+        return workers.count();
+    }
+
+    //Number of batches stolen so far
+    long long steals() const {
+        return stealCount.load(std::memory_order_relaxed);
+    }
+
+    //Number of jobs waiting in the queues, cancelled ones included until a worker drops them
+    int queuedTasks() const {
+        return queued.load(std::memory_order_relaxed);
+    }
+
+    //Queues function to run with priority, returns the handle to its result
+    template <typename F>
+    TaskHandle<std::invoke_result_t<std::decay_t<F>&>> submit(F&& function, int priority) {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        auto job = std::make_shared<PoolTaskJob<R, std::decay_t<F>>>(std::forward<F>(function));
+        std::future<R> result = job->future();
+        int index = currentWorker();
+        if (index == -1) {
+            index = static_cast<int>(nextWorker.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned>(workers.count()));
+        }
+        push(index, job, priority);
+        return TaskHandle<R>(std::move(job), std::move(result));
+    }
+};
+
+#endif //SD_P2_PRIORITYTHREADPOOL_H
@@ -0,0 +1,104 @@
+#ifndef RANK_ERROR_METER_H
+#define RANK_ERROR_METER_H
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+//Measures how far a relaxed queue is from an exact one
+//It keeps the multiset of priorities in the queue in a Fenwick tree, and the rank of a removed priority is the
+//number of priorities in the queue smaller than it – 0 for a queue that always removes the minimum
+//Priorities have to be recorded as inserted before they enter the queue, so the tree never misses one
+//that some thread may already remove; all calls take one lock, the meter is meant for measuring runs only
+class RankErrorMeter {
+public:
+	RankErrorMeter(int maxPriority); //Constructor for priorities in [0, maxPriority]
+	void inserted(int priority); //Record a priority about to enter the queue
+	void removed(int priority); //Record a priority that left the queue together with its rank
+	void erased(int priority); //Record a priority that left the queue other than by a dequeue, without a rank
+	double meanRank() const; //Get average rank of the removed priorities
+	long long maxRank() const; //Get largest rank of a removed priority
+	long long removals() const; //Get number of recorded removals
+private:
+	void add(int priority, int delta); //Change the count of priority by delta
+	long long countBelow(int priority) const; //Get number of priorities in the queue smaller than priority
+	void checkPriority(int priority) const; //Check if priority is in range
+	mutable std::mutex mutex_; //Lock guarding the tree and the statistics
+	std::vector<int> tree_; //Fenwick tree of priority counts, 1-based
+	long long rankSum_; //Sum of the ranks of removed priorities
+	long long maxRank_; //Largest rank of a removed priority
+	long long removals_; //Number of removed priorities
+};
+
+//Constructor for priorities in [0, maxPriority]
+inline RankErrorMeter::RankErrorMeter(int maxPriority) : rankSum_(0), maxRank_(0), removals_(0) {
+	if (maxPriority < 0)
+		throw std::invalid_argument("Largest priority is negative"); //Check for empty range
+	tree_.assign(static_cast<size_t>(maxPriority) + 2, 0);
+}
+
+//Record a priority about to enter the queue
+inline void RankErrorMeter::inserted(int priority) {
+	checkPriority(priority);
+	std::lock_guard<std::mutex> guard(mutex_);
+	add(priority, 1);
+}
+
+//Record a priority that left the queue together with its rank
+inline void RankErrorMeter::removed(int priority) {
+	checkPriority(priority);
+	std::lock_guard<std::mutex> guard(mutex_);
+	long long rank = countBelow(priority);
+	add(priority, -1);
+	rankSum_ += rank;
+	if (rank > maxRank_)
+		maxRank_ = rank;
+	removals_++;
+}
+
+//Record a priority that left the queue other than by a dequeue, without a rank
+inline void RankErrorMeter::erased(int priority) {
+	checkPriority(priority);
+	std::lock_guard<std::mutex> guard(mutex_);
+	add(priority, -1);
+}
+
+//Get average rank of the removed priorities
+inline double RankErrorMeter::meanRank() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return removals_ == 0 ? 0.0 : static_cast<double>(rankSum_) / removals_;
+}
+
+//Get largest rank of a removed priority
+inline long long RankErrorMeter::maxRank() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return maxRank_;
+}
+
+//Get number of recorded removals
+inline long long RankErrorMeter::removals() const {
+	std::lock_guard<std::mutex> guard(mutex_);
+	return removals_;
+}
+
+//Change the count of priority by delta
+inline void RankErrorMeter::add(int priority, int delta) {
+	for (size_t i = static_cast<size_t>(priority) + 1; i < tree_.size(); i += i & (~i + 1))
+		tree_[i] += delta;
+}
+
+//Get number of priorities in the queue smaller than priority
+inline long long RankErrorMeter::countBelow(int priority) const {
+	long long count = 0;
+	for (size_t i = static_cast<size_t>(priority); i > 0; i -= i & (~i + 1))
+		count += tree_[i];
+	return count;
+}
+
+//Check if priority is in range
+inline void RankErrorMeter::checkPriority(int priority) const {
+	if (priority < 0 || static_cast<size_t>(priority) + 2 > tree_.size())
+		throw std::out_of_range("Priority out of range"); //Check for valid priority
+}
+
+#endif // !RANK_ERROR_METER_H
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "PriorityQueue.h"
+#include "PriorityQueueMinHeap.h"
+#include "ConcurrentSync.h"
+
+#ifndef SD_P2_SHARDEDPRIORITYQUEUE_H
+#define SD_P2_SHARDEDPRIORITYQUEUE_H
+
+//One heap per worker thread with work stealing
+//A thread enqueues into and dequeues from its own shard, whose lock no other thread touches except to steal,
+//so in the common case a call costs one uncontended atomic exchange
+//A thread steals when its shard runs empty or when its head is behind the best head of the other shards
+//by more than stealThreshold; it then takes up to half of the victim's smallest elements, at most STEAL_BATCH,
+//and adds them to its own heap with one insertBulk
+//Threads are mapped to shards by ThreadIndex, so with at most as many threads as shards every thread has its own
+template <typename T>
+class ShardedPriorityQueue : public PriorityQueue<T> {
+public:
+    static constexpr int STEAL_WHEN_EMPTY = -1; //Threshold letting a thread steal only once its own shard is empty
+
+private:
+    using Shards = LockedLanes<MinHeap<Node<T>>>;
+    using Shard = typename Shards::Lane;
+    static constexpr long long EMPTY = Shards::EMPTY;
+    static constexpr int STEAL_BATCH = 32;
+
+    Shards shards;
+    long long stealThreshold;
+    std::atomic<int> size;
+    std::atomic<long long> stealCount;
+
+    int localShard() const {
+        return ThreadIndex::current() % shards.count();
+    }
+
+    //Moves the smallest elements of victim into own, the two locks are never held together
+    void steal(Shard& victim, Shard& own) {
+        DynamicArray<Node<T>> batch(STEAL_BATCH);
+        {
+            std::lock_guard<SpinLockSync> guard(victim.lock);
+            int take = std::min(STEAL_BATCH, std::max(1, victim.heap.size() / 2));
+            for (int i = 0; i < take && !victim.heap.empty(); i++) {
+                batch.pushBack(victim.heap.extractMin());
+            }
+            victim.updateTop();
+        }
+        if (batch.empty()) return;
+        std::lock_guard<SpinLockSync> guard(own.lock);
+        own.heap.insertBulk(batch);
+        own.updateTop();
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    explicit ShardedPriorityQueue(int workers = static_cast<int>(std::thread::hardware_concurrency()),
+                                  int stealThreshold = STEAL_WHEN_EMPTY)
+        : shards(std::max(1, workers)), stealThreshold(stealThreshold), size(0), stealCount(0) {
+        if (stealThreshold < STEAL_WHEN_EMPTY) throw std::invalid_argument("Steal threshold is negative");
+    }
+
+    ShardedPriorityQueue(const ShardedPriorityQueue&) = delete;
+    ShardedPriorityQueue& operator=(const ShardedPriorityQueue&) = delete;
+
+    int workerCount() const {
+        return shards.count();
+    }
+
+    //Number of batches stolen so far
+    long long steals() const {
+        return stealCount.load(std::memory_order_relaxed);
+    }
+
+    void enqueue(T element, int priority) override {
+        Shard& own = shards[localShard()];
+        size.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<SpinLockSync> guard(own.lock);
+        own.heap.insert(Node<T>(std::move(element), priority));
+        own.updateTop();
+    }
+
+    T dequeue() override {
+        T element;
+        if (!tryDequeue(element)) throw std::runtime_error("Queue is empty");
+        return element;
+    }
+
+    //Removes the head of the own shard into element after stealing if needed, returns false if the queue is empty
+    bool tryDequeue(T& element) {
+        int local = localShard();
+        Shard& own = shards[local];
+        while (true) {
+            long long ownTop = own.top.load(std::memory_order_relaxed);
+            int victim = ownTop == EMPTY || stealThreshold != STEAL_WHEN_EMPTY ? shards.best(local) : -1;
+            if (victim != -1) {
+                long long victimTop = shards.top(victim);
+                //Both heads come from int priorities once neither is EMPTY, so their difference cannot overflow
+                bool behind = stealThreshold != STEAL_WHEN_EMPTY && ownTop != EMPTY && victimTop != EMPTY
+                    && ownTop - victimTop > stealThreshold;
+                if (ownTop == EMPTY || behind) {
+                    steal(shards[victim], own);
+                }
+            }
+            {
+                std::lock_guard<SpinLockSync> guard(own.lock);
+                if (!own.heap.empty()) {
+                    element = std::move(own.heap.extractMin().element);
+                    own.updateTop();
+                    size.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            //Elements being stolen are counted but in no heap, so only the count tells that the queue is empty
+            if (size.load(std::memory_order_relaxed) == 0) return false;
+            std::this_thread::yield();
+        }
+    }
+
+    //Head of the shard with the smallest head, exact only while no other thread changes the queue
+    T peek() const override {
+        while (true) {
+            int best = shards.best();
+            if (best == -1) {
+                if (size.load(std::memory_order_relaxed) == 0) throw std::runtime_error("Queue is empty");
+                continue;
+            }
+            std::lock_guard<SpinLockSync> guard(shards[best].lock);
+            if (!shards[best].heap.empty()) return shards[best].heap.min().element;
+        }
+    }
+
+    int peekPriority() const override {
+        while (true) {
+            int best = shards.best();
+            if (best == -1) {
+                if (size.load(std::memory_order_relaxed) == 0) throw std::runtime_error("Queue is empty");
+                continue;
+            }
+            std::lock_guard<SpinLockSync> guard(shards[best].lock);
+            if (!shards[best].heap.empty()) return shards[best].heap.min().priority;
+        }
+    }
+
+    int getSize() const override {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    void modifyPriority(T element, int newPriority) override {
+        shards.untilLocked([&](Shard& shard) {
+            for (int j = 0; j < shard.heap.size(); j++) {
+                if (shard.heap.get(j).element == element) {
+                    Node<T> node = shard.heap.get(j);
+                    node.priority = newPriority;
+                    shard.heap.replace(j, node);
+                    shard.updateTop();
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    bool isEmpty() const override {
+        return getSize() == 0;
+    }
+
+    //Locks one shard at a time, so it is a consistent picture only while no other thread changes the queue
+    void forEachEntry(const std::function<void(const T&, int)>& visit) const override {
+        shards.untilLocked([&](Shard& shard) {
+            for (int j = 0; j < shard.heap.size(); j++) {
+                visit(shard.heap.get(j).element, shard.heap.get(j).priority);
+            }
+            return false;
+        });
+    }
+};
+
+#endif //SD_P2_SHARDEDPRIORITYQUEUE_H
@@ -0,0 +1,214 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//Binary snapshot of a queue – a fixed header followed by count records of (int32 priority, payload)
+//Numbers are stored in the byte order of the machine, snapshots are meant to be restored where they were taken
+//With a trivially copyable payload every record has the same size, which the header records in recordSize
+//Records are not laid out like Node<T>, so a restore always reads and copies them; a HeapArray snapshot only saves
+//the heapify, a heap that needs no restore at all is kept in a MappedArray instead
+enum class SnapshotLayout : uint32_t {
+	Stream = 0, //Records in no particular order
+	HeapArray = 1 //Records in the array order of a binary min-heap
+};
+
+//Header at the beginning of a snapshot file
+struct SnapshotHeader {
+	char magic[4]; //Always "SDPQ"
+	uint32_t version; //Format version
+	SnapshotLayout layout; //Order of the records
+	uint32_t recordSize; //Size of a record for fixed-size payloads, 0 otherwise
+	uint64_t count; //Number of records
+};
+
+//Element together with its priority as read from a snapshot
+template <typename T>
+struct SnapshotEntry {
+	int priority;
+	T element;
+};
+
+//Writes and reads the payload of a record
+//Specialize it for element types that are neither trivially copyable nor strings
+//The snapshot methods of PriorityQueue are virtual and so compiled for every element type, queues of pointers
+//included; for a type without a serializer they throw instead of failing the build
+template <typename T, typename Enable = void>
+struct SnapshotSerializer {
+	static constexpr uint32_t FIXED_SIZE = 0; //Records of this type differ in size
+	static void write(std::ostream&, const T&) {
+		throw std::logic_error("No snapshot serializer for this element type");
+	}
+	static T read(std::istream&) {
+		throw std::logic_error("No snapshot serializer for this element type");
+	}
+};
+
+//Trivially copyable payloads are stored byte by byte, pointers are excluded since they do not survive a restart
+template <typename T>
+struct SnapshotSerializer<T, std::enable_if_t<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>>> {
+	static constexpr uint32_t FIXED_SIZE = sizeof(T); //Every payload has the same size
+	static void write(std::ostream& out, const T& element) {
+		out.write(reinterpret_cast<const char*>(&element), sizeof(T));
+	}
+	static T read(std::istream& in) {
+		T element;
+		in.read(reinterpret_cast<char*>(&element), sizeof(T));
+		return element;
+	}
+};
+
+//Strings are stored as their length followed by their characters
+template <>
+struct SnapshotSerializer<std::string> {
+	static constexpr uint32_t FIXED_SIZE = 0; //Records differ in size
+	static void write(std::ostream& out, const std::string& element) {
+		uint32_t length = static_cast<uint32_t>(element.size());
+		out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		out.write(element.data(), length);
+	}
+	static std::string read(std::istream& in) {
+		uint32_t length = 0;
+		in.read(reinterpret_cast<char*>(&length), sizeof(length));
+		std::string element(length, '\0');
+		in.read(element.data(), length);
+		return element;
+	}
+};
+
+//Writes a snapshot file record by record, the header is completed on close
+template <typename T, typename Serializer = SnapshotSerializer<T>>
+class SnapshotWriter {
+public:
+	SnapshotWriter(const std::string& path, SnapshotLayout layout); //Constructor creating the file
+	void write(const T& element, int priority); //Append record
+	void close(); //Complete the header and close the file
+private:
+	std::ofstream out_; //Output file
+	SnapshotHeader header_; //Header written on close
+};
+
+//Reads a snapshot file written by SnapshotWriter
+template <typename T, typename Serializer = SnapshotSerializer<T>>
+class SnapshotReader {
+public:
+	SnapshotReader(const std::string& path); //Constructor opening the file and checking its header
+	SnapshotLayout layout() const; //Get order of the records
+	uint64_t count() const; //Get number of records
+	SnapshotEntry<T> read(); //Read next record
+	void readAll(std::vector<SnapshotEntry<T>>& entries); //Append all remaining records to entries
+private:
+	static constexpr size_t BLOCK_RECORDS = 65536; //Fixed-size records read from the file at once
+	static constexpr size_t RECORD_SIZE = sizeof(int32_t) + Serializer::FIXED_SIZE; //Size of a fixed-size record
+	std::ifstream in_; //Input file
+	std::vector<char> block_; //Fixed-size records read ahead
+	size_t blockPosition_; //Offset of the next record in the block
+	SnapshotHeader header_; //Header of the file
+	uint64_t read_; //Number of records read so far
+};
+
+//Constructor creating the file
+template <typename T, typename Serializer>
+SnapshotWriter<T, Serializer>::SnapshotWriter(const std::string& path, SnapshotLayout layout)
+	: out_(path, std::ios::binary | std::ios::trunc) {
+	if (!out_)
+		throw std::runtime_error("Cannot create snapshot " + path); //Check if file was created
+	std::memcpy(header_.magic, "SDPQ", 4);
+	header_.version = 1;
+	header_.layout = layout;
+	header_.recordSize = Serializer::FIXED_SIZE ? static_cast<uint32_t>(sizeof(int32_t) + Serializer::FIXED_SIZE) : 0;
+	header_.count = 0;
+	out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_)); //Placeholder until the count is known
+}
+
+//Append record
+template <typename T, typename Serializer>
+void SnapshotWriter<T, Serializer>::write(const T& element, int priority) {
+	int32_t stored = priority;
+	out_.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+	Serializer::write(out_, element);
+	header_.count++;
+}
+
+//Complete the header and close the file
+template <typename T, typename Serializer>
+void SnapshotWriter<T, Serializer>::close() {
+	out_.seekp(0);
+	out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+	out_.close();
+	if (!out_)
+		throw std::runtime_error("Cannot write snapshot"); //Check for full disk
+}
+
+//Constructor opening the file and checking its header
+template <typename T, typename Serializer>
+SnapshotReader<T, Serializer>::SnapshotReader(const std::string& path) : in_(path, std::ios::binary), blockPosition_(0), read_(0) {
+	if (!in_)
+		throw std::runtime_error("Cannot open snapshot " + path); //Check if file was opened
+	in_.read(reinterpret_cast<char*>(&header_), sizeof(header_));
+	if (!in_ || std::memcmp(header_.magic, "SDPQ", 4) != 0 || header_.version != 1)
+		throw std::runtime_error("Not a queue snapshot: " + path); //Check header
+	uint32_t recordSize = Serializer::FIXED_SIZE ? static_cast<uint32_t>(sizeof(int32_t) + Serializer::FIXED_SIZE) : 0;
+	if (header_.recordSize != recordSize)
+		throw std::runtime_error("Snapshot was written for another element type: " + path); //Check payload size
+}
+
+//Get order of the records
+template <typename T, typename Serializer>
+SnapshotLayout SnapshotReader<T, Serializer>::layout() const {
+	return header_.layout;
+}
+
+//Get number of records
+template <typename T, typename Serializer>
+uint64_t SnapshotReader<T, Serializer>::count() const {
+	return header_.count;
+}
+
+//Read next record
+template <typename T, typename Serializer>
+SnapshotEntry<T> SnapshotReader<T, Serializer>::read() {
+	if (read_ == header_.count)
+		throw std::out_of_range("Snapshot has no more records"); //Check for end of records
+	int32_t priority = 0;
+	if constexpr (Serializer::FIXED_SIZE != 0) {
+		if (blockPosition_ == block_.size()) {
+			uint64_t left = header_.count - read_;
+			block_.resize((left < BLOCK_RECORDS ? left : BLOCK_RECORDS) * RECORD_SIZE);
+			in_.read(block_.data(), static_cast<std::streamsize>(block_.size())); //Read many records with one call
+			if (!in_)
+				throw std::runtime_error("Snapshot is truncated"); //Check for end of file
+			blockPosition_ = 0;
+		}
+		T element;
+		std::memcpy(&priority, block_.data() + blockPosition_, sizeof(priority));
+		std::memcpy(&element, block_.data() + blockPosition_ + sizeof(priority), sizeof(T));
+		blockPosition_ += RECORD_SIZE;
+		read_++;
+		return SnapshotEntry<T>{priority, element};
+	}
+	else {
+		in_.read(reinterpret_cast<char*>(&priority), sizeof(priority));
+		T element = Serializer::read(in_);
+		if (!in_)
+			throw std::runtime_error("Snapshot is truncated"); //Check for end of file
+		read_++;
+		return SnapshotEntry<T>{priority, element};
+	}
+}
+
+//Append all remaining records to entries
+template <typename T, typename Serializer>
+void SnapshotReader<T, Serializer>::readAll(std::vector<SnapshotEntry<T>>& entries) {
+	entries.reserve(entries.size() + (header_.count - read_));
+	while (read_ < header_.count)
+		entries.push_back(read());
+}
+
+#endif // !SNAPSHOT_H
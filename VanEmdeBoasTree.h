@@ -0,0 +1,145 @@
+#ifndef VAN_EMDE_BOAS_TREE_H
+#define VAN_EMDE_BOAS_TREE_H
+
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//Van Emde Boas tree over the keys [0, 2^Bits)
+//The upper half of a key's bits selects a cluster and the lower half is stored inside it, a summary tree
+//tracks the non-empty clusters and the minimum is kept out of the clusters, so every operation recurses
+//into a single subtree and takes O(log Bits) = O(log log U) steps
+//Subtrees of at most 64 keys are a single machine word
+template <int Bits, bool Leaf = (Bits <= 6)>
+class VanEmdeBoasTree {
+public:
+	VanEmdeBoasTree(); //Default constructor
+	void insert(int key); //Insert key that is not in the tree yet
+	void remove(int key); //Remove key that is in the tree
+	bool contains(int key) const; //Check if key is in the tree
+	int min() const; //Get smallest key or -1
+	int max() const; //Get largest key or -1
+	int successor(int key) const; //Get smallest key greater than key or -1
+	bool empty() const; //Check if the tree holds no key
+private:
+	static constexpr int LOW_BITS = Bits / 2; //Bits stored inside a cluster
+	static constexpr int HIGH_BITS = Bits - LOW_BITS; //Bits selecting the cluster
+	static int high(int key) { return key >> LOW_BITS; } //Get cluster of key
+	static int low(int key) { return key & ((1 << LOW_BITS) - 1); } //Get position of key inside its cluster
+	static int index(int cluster, int position) { return (cluster << LOW_BITS) | position; } //Join cluster and position
+	int min_; //Smallest key, not stored in any cluster
+	int max_; //Largest key, also stored in its cluster unless it equals the minimum
+	VanEmdeBoasTree<HIGH_BITS> summary_; //Tree of non-empty clusters
+	std::vector<VanEmdeBoasTree<LOW_BITS>> clusters_; //Clusters holding the lower bits of the keys
+};
+
+//Tree over at most 64 keys kept in a single word
+template <int Bits>
+class VanEmdeBoasTree<Bits, true> {
+public:
+	void insert(int key) { bits_ |= uint64_t(1) << key; } //Insert key
+	void remove(int key) { bits_ &= ~(uint64_t(1) << key); } //Remove key
+	bool contains(int key) const { return (bits_ >> key) & 1; } //Check if key is in the tree
+	int min() const { return bits_ ? std::countr_zero(bits_) : -1; } //Get smallest key or -1
+	int max() const { return bits_ ? 63 - std::countl_zero(bits_) : -1; } //Get largest key or -1
+	bool empty() const { return bits_ == 0; } //Check if the tree holds no key
+
+	//Get smallest key greater than key or -1
+	int successor(int key) const {
+		if (key >= 63)
+			return -1;
+		uint64_t above = bits_ & (~uint64_t(0) << (key + 1)); //Drop key and everything below it
+		return above ? std::countr_zero(above) : -1;
+	}
+private:
+	uint64_t bits_ = 0; //Bit k is set if key k is in the tree
+};
+
+//Default constructor
+template <int Bits, bool Leaf>
+VanEmdeBoasTree<Bits, Leaf>::VanEmdeBoasTree() : min_(-1), max_(-1), clusters_(1 << HIGH_BITS) {}
+
+//Insert key that is not in the tree yet
+template <int Bits, bool Leaf>
+void VanEmdeBoasTree<Bits, Leaf>::insert(int key) {
+	if (min_ == -1) {
+		min_ = max_ = key; //Empty tree only needs its minimum
+		return;
+	}
+	if (key < min_)
+		std::swap(key, min_); //New key becomes the minimum and the old minimum goes down instead
+	if (key > max_)
+		max_ = key;
+	VanEmdeBoasTree<LOW_BITS>& cluster = clusters_[high(key)];
+	if (cluster.empty())
+		summary_.insert(high(key)); //First key of the cluster, inserting into it is then O(1)
+	cluster.insert(low(key));
+}
+
+//Remove key that is in the tree
+template <int Bits, bool Leaf>
+void VanEmdeBoasTree<Bits, Leaf>::remove(int key) {
+	if (min_ == max_) {
+		min_ = max_ = -1; //Last key leaves the tree
+		return;
+	}
+	if (key == min_) {
+		int first = summary_.min(); //Pull the smallest clustered key up as the new minimum
+		key = index(first, clusters_[first].min());
+		min_ = key;
+	}
+	VanEmdeBoasTree<LOW_BITS>& cluster = clusters_[high(key)];
+	cluster.remove(low(key));
+	if (cluster.empty())
+		summary_.remove(high(key)); //Cluster got empty, removing from it was O(1)
+	if (key == max_) {
+		int last = summary_.max();
+		max_ = last == -1 ? min_ : index(last, clusters_[last].max());
+	}
+}
+
+//Check if key is in the tree
+template <int Bits, bool Leaf>
+bool VanEmdeBoasTree<Bits, Leaf>::contains(int key) const {
+	if (key == min_ || key == max_)
+		return min_ != -1;
+	if (min_ == -1 || key < min_ || key > max_)
+		return false;
+	return clusters_[high(key)].contains(low(key));
+}
+
+//Get smallest key or -1
+template <int Bits, bool Leaf>
+int VanEmdeBoasTree<Bits, Leaf>::min() const {
+	return min_;
+}
+
+//Get largest key or -1
+template <int Bits, bool Leaf>
+int VanEmdeBoasTree<Bits, Leaf>::max() const {
+	return max_;
+}
+
+//Get smallest key greater than key or -1
+template <int Bits, bool Leaf>
+int VanEmdeBoasTree<Bits, Leaf>::successor(int key) const {
+	if (min_ == -1 || key >= max_)
+		return -1;
+	if (key < min_)
+		return min_;
+	int cluster = high(key);
+	int last = clusters_[cluster].max();
+	if (last != -1 && low(key) < last)
+		return index(cluster, clusters_[cluster].successor(low(key))); //Successor lies in the same cluster
+	int next = summary_.successor(cluster); //Otherwise it is the minimum of the next non-empty cluster
+	return index(next, clusters_[next].min());
+}
+
+//Check if the tree holds no key
+template <int Bits, bool Leaf>
+bool VanEmdeBoasTree<Bits, Leaf>::empty() const {
+	return min_ == -1;
+}
+
+#endif // !VAN_EMDE_BOAS_TREE_H
@@ -1,13 +1,43 @@
 ﻿#include <iostream>
 #include <chrono>
+#include <ctime>
+#include <climits>
 #include <string>
 #include <map>
 #include <random>
 #include <cassert>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include "PriorityQueueLinkedList.h"
 #include "PriorityQueueFibonacciHeap.h"
 #include "PriorityQueueMinHeap.h"
+#include "PriorityQueueUnrolledLinkedList.h"
+#include "PriorityQueueBucket.h"
+#include "PriorityQueueRadixHeap.h"
+#include "PriorityQueueTimingWheel.h"
+#include "PriorityQueueCalendar.h"
+#include "PriorityQueuePairingHeap.h"
+#include "PriorityQueueBinomialHeap.h"
+#include "PriorityQueueMinMaxHeap.h"
+#include "PriorityQueueVanEmdeBoas.h"
+#include "PriorityQueueSequenceHeap.h"
+#include "PriorityQueueExternal.h"
+#include "PriorityQueueFlatCombining.h"
+#include "PriorityQueueLockFreeSkipList.h"
+#include "PriorityQueueMultiQueue.h"
+#include "PriorityQueueFineGrainedHeap.h"
+#include "BoundedPriorityQueue.h"
+#include "ShardedPriorityQueue.h"
+#include "IngestionPriorityQueue.h"
+#include "BlockingPriorityQueue.h"
+#include "PriorityExecutor.h"
+#include "AsyncPriorityQueue.h"
+#include "PriorityThreadPool.h"
+#include "ConcurrentPriorityQueue.h"
 #include "MinHeap.h"
+#include "MappedArray.h"
 
 using namespace std;
 
@@ -27,7 +57,879 @@ int generateRandomPriority() {
 	return dist(gen);
 }
 
-int main() {
+//Runs Dijkstra's algorithm with lazy deletion, the extracted distances never decrease
+long long dijkstra(PriorityQueue<int>* pq, const vector<vector<pair<int, int>>>& graph, int source) {
+    vector<long long> distance(graph.size(), -1);
+    vector<int> tentative(graph.size(), INT32_MAX);
+    tentative[source] = 0;
+    pq->enqueue(source, 0);
+    long long checksum = 0;
+    while (!pq->isEmpty()) {
+        int vertex = pq->dequeue();
+        if (distance[vertex] != -1) continue;
+        distance[vertex] = tentative[vertex];
+        checksum += distance[vertex];
+        for (auto [neighbour, weight] : graph[vertex]) {
+            int candidate = tentative[vertex] + weight;
+            if (distance[neighbour] == -1 && candidate < tentative[neighbour]) {
+                tentative[neighbour] = candidate;
+                pq->enqueue(neighbour, candidate);
+            }
+        }
+    }
+    return checksum;
+}
+
+void dijkstraBenchmark() {
+    int graphSize[] = {1000, 10000, 100000, 1000000};
+    int edgesPerVertex = 8;
+    mt19937 gen(2025);
+    cout << "Dijkstra\n";
+    for (int size : graphSize) {
+        vector<vector<pair<int, int>>> graph(size);
+        uniform_int_distribution<> vertexDist(0, size - 1);
+        uniform_int_distribution<> weightDist(1, 1000);
+        for (int v = 0; v < size; v++) {
+            for (int e = 0; e < edgesPerVertex; e++) {
+                graph[v].push_back({vertexDist(gen), weightDist(gen)});
+            }
+        }
+
+        PriorityQueueFibonacciHeap<int> fibonacciHeap;
+        auto start = chrono::high_resolution_clock::now();
+        [[maybe_unused]] long long fibonacciChecksum = dijkstra(&fibonacciHeap, graph, 0);
+        auto stop = chrono::high_resolution_clock::now();
+        double fibonacciTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        PriorityQueueRadixHeap<int> radixHeap;
+        start = chrono::high_resolution_clock::now();
+        [[maybe_unused]] long long radixChecksum = dijkstra(&radixHeap, graph, 0);
+        stop = chrono::high_resolution_clock::now();
+        double radixTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        PriorityQueuePairingHeap<int> pairingHeap;
+        start = chrono::high_resolution_clock::now();
+        [[maybe_unused]] long long pairingChecksum = dijkstra(&pairingHeap, graph, 0);
+        stop = chrono::high_resolution_clock::now();
+        double pairingTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        assert(fibonacciChecksum == radixChecksum);
+        assert(fibonacciChecksum == pairingChecksum);
+        cout << "Vertices: " << size << "; Fibonacci Heap: " << fibonacciTime << " ms; Radix Heap: "
+        << radixTime << " ms; Pairing Heap: " << pairingTime << " ms\n";
+    }
+}
+
+//Timer mix where every tick schedules a timer and nine out of ten timers get cancelled before firing
+void timerBenchmark() {
+    int timerCount[] = {10000, 100000, 1000000};
+    int maxDelay = 10000;
+    int cancelDelay = 50;
+    cout << "Timers\n";
+    for (int count : timerCount) {
+        mt19937 gen(2025);
+        uniform_int_distribution<> delayDist(cancelDelay + 1, maxDelay);
+        vector<int> deadlines(count);
+        for (int i = 0; i < count; i++) {
+            deadlines[i] = i + delayDist(gen);
+        }
+
+        //Timing wheel cancels directly through handles
+        PriorityQueueTimingWheel<int> wheel;
+        vector<PriorityQueueTimingWheel<int>::Handle> handles(count);
+        DynamicArray<int> expired;
+        int wheelFired = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int now = 0; now < count + maxDelay; now++) {
+            if (now < count) {
+                handles[now] = wheel.schedule(now, deadlines[now]);
+            }
+            int victim = now - cancelDelay;
+            if (victim >= 0 && victim < count && victim % 10 != 0) {
+                wheel.cancel(handles[victim]);
+            }
+            expired.clear();
+            wheel.advanceTo(now, expired);
+            wheelFired += expired.size();
+        }
+        auto stop = chrono::high_resolution_clock::now();
+        double wheelTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        //Heap can only mark cancelled timers and skip them once they reach the top
+        MinHeap<Node<int>> heap;
+        vector<bool> cancelled(count, false);
+        int heapFired = 0;
+        start = chrono::high_resolution_clock::now();
+        for (int now = 0; now < count + maxDelay; now++) {
+            if (now < count) {
+                heap.insert(Node<int>(now, deadlines[now]));
+            }
+            int victim = now - cancelDelay;
+            if (victim >= 0 && victim < count && victim % 10 != 0) {
+                cancelled[victim] = true;
+            }
+            while (!heap.empty() && heap.min().priority <= now) {
+                Node<int> node = heap.extractMin();
+                if (!cancelled[node.element]) heapFired++;
+            }
+        }
+        stop = chrono::high_resolution_clock::now();
+        double heapTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        assert(wheelFired == heapFired);
+        cout << "Timers: " << count << "; Timing Wheel: " << wheelTime << " ms; Heap: " << heapTime << " ms\n";
+    }
+}
+
+//Hold model – every step dequeues the earliest event and schedules its successor a random time later
+double holdModel(PriorityQueue<int>* pq, int size, int steps) {
+    mt19937 gen(2025);
+    exponential_distribution<> incrementDist(1.0 / 1000);
+    for (int i = 0; i < size; i++) {
+        int time = static_cast<int>(incrementDist(gen));
+        pq->enqueue(time, time);
+    }
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < steps; i++) {
+        int time = pq->dequeue();
+        time += 1 + static_cast<int>(incrementDist(gen));
+        pq->enqueue(time, time);
+    }
+    auto stop = chrono::high_resolution_clock::now();
+    while (!pq->isEmpty()) {
+        pq->dequeue();
+    }
+    return chrono::duration_cast<chrono::nanoseconds>(stop - start).count() / static_cast<double>(steps);
+}
+
+void holdBenchmark() {
+    int holdSize[] = {100, 1000, 10000, 100000, 1000000};
+    int steps = 1000000;
+    cout << "Hold model (ns per hold)\n";
+    for (int size : holdSize) {
+        PriorityQueueMinHeap<int> heap;
+        PriorityQueueFibonacciHeap<int> fibonacciHeap;
+        PriorityQueueCalendar<int> calendarQueue;
+        PriorityQueuePairingHeap<int> pairingHeap;
+        double heapTime = holdModel(&heap, size, steps);
+        double fibonacciTime = holdModel(&fibonacciHeap, size, steps);
+        double calendarTime = holdModel(&calendarQueue, size, steps);
+        double pairingTime = holdModel(&pairingHeap, size, steps);
+        cout << "Size: " << size << "; Heap: " << heapTime << "; Fibonacci Heap: " << fibonacciTime
+        << "; Calendar Queue: " << calendarTime << "; Pairing Heap: " << pairingTime << "\n";
+    }
+}
+
+//Keeps the best 100 priorities of a stream, by draining a full heap and with the bounded queue
+void topKBenchmark() {
+    constexpr int K = 100;
+    int streamSize[] = {100000, 1000000, 10000000};
+    cout << "Top " << K << "\n";
+    for (int count : streamSize) {
+        mt19937 gen(2025);
+        uniform_int_distribution<> dist(1, 1000000000);
+        vector<int> elements(count);
+        vector<int> priorities(count);
+        for (int i = 0; i < count; i++) {
+            elements[i] = i;
+            priorities[i] = dist(gen);
+        }
+
+        PriorityQueueMinHeap<int> heap;
+        long long heapSum = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < count; i++) {
+            heap.enqueue(elements[i], priorities[i]);
+        }
+        for (int i = 0; i < K; i++) {
+            heapSum += priorities[heap.dequeue()];
+        }
+        auto stop = chrono::high_resolution_clock::now();
+        double heapTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        auto* bounded = new BoundedPriorityQueue<int, K>();
+        DynamicArray<int> best;
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < count; i++) {
+            bounded->offer(elements[i], priorities[i]);
+        }
+        bounded->drain(best);
+        stop = chrono::high_resolution_clock::now();
+        double offerTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+        long long offerSum = 0;
+        for (int i = 0; i < best.size(); i++) {
+            offerSum += priorities[best[i]];
+        }
+
+        best.clear();
+        start = chrono::high_resolution_clock::now();
+        bounded->offerBulk(span<const int>(elements), span<const int>(priorities));
+        bounded->drain(best);
+        stop = chrono::high_resolution_clock::now();
+        double bulkTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+        long long bulkSum = 0;
+        for (int i = 0; i < best.size(); i++) {
+            bulkSum += priorities[best[i]];
+        }
+        delete bounded;
+
+        assert(heapSum == offerSum && offerSum == bulkSum);
+        cout << "Stream: " << count << "; Heap: " << heapTime << " ms; Bounded: " << offerTime
+             << " ms; Bounded bulk: " << bulkTime << " ms\n";
+    }
+}
+
+//Fills the queue with random priorities and drains it, returns nanoseconds per element
+double fillAndDrain(PriorityQueue<int>* pq, int size) {
+    mt19937 gen(2025);
+    uniform_int_distribution<> dist(0, 1000000000);
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < size; i++) {
+        pq->enqueue(i, dist(gen));
+    }
+    [[maybe_unused]] int lastPriority = -1;
+    while (!pq->isEmpty()) {
+        int priority = pq->peekPriority();
+        assert(priority >= lastPriority);
+        lastPriority = priority;
+        pq->dequeue();
+    }
+    auto stop = chrono::high_resolution_clock::now();
+    return chrono::duration_cast<chrono::nanoseconds>(stop - start).count() / static_cast<double>(size);
+}
+
+//Sizes past queueSize[], where the binary heap no longer fits in cache
+void scalingBenchmark(int maxSize) {
+    int scalingSize[] = {100000, 1000000, 10000000, 100000000};
+    cout << "Scaling (ns per element)\n";
+    for (int size : scalingSize) {
+        if (size > maxSize) break;
+        auto* heap = new PriorityQueueMinHeap<int>();
+        double heapTime = fillAndDrain(heap, size);
+        delete heap;
+        auto* sequenceHeap = new PriorityQueueSequenceHeap<int>();
+        double sequenceTime = fillAndDrain(sequenceHeap, size);
+        delete sequenceHeap;
+        cout << "Size: " << size << "; Heap: " << heapTime << "; Sequence Heap: " << sequenceTime << "\n";
+    }
+}
+
+//External queue limited to 16 MB of heap against the in-memory heap, runs go to the system's temporary directory
+void externalBenchmark() {
+    int externalSize[] = {1000000, 10000000, 50000000};
+    size_t memoryBudget = size_t(16) << 20;
+    cout << "External memory (ns per element)\n";
+    for (int size : externalSize) {
+        auto* heap = new PriorityQueueMinHeap<int>();
+        double heapTime = fillAndDrain(heap, size);
+        delete heap;
+        auto* external = new PriorityQueueExternal<int>(memoryBudget);
+        double externalTime = fillAndDrain(external, size);
+        delete external;
+        cout << "Size: " << size << "; Heap: " << heapTime << "; External: " << externalTime << "\n";
+    }
+}
+
+//Restoring a queue after a restart, by enqueuing every element again and by loading a snapshot
+void snapshotBenchmark() {
+    int snapshotSize[] = {100000, 1000000, 10000000};
+    string path = "queue.snapshot";
+    cout << "Snapshot restore\n";
+    for (int size : snapshotSize) {
+        mt19937 gen(2025);
+        uniform_int_distribution<> dist(1, 1000000);
+        PriorityQueueMinHeap<int> original;
+        for (int i = 0; i < size; i++) {
+            original.enqueue(i, dist(gen));
+        }
+
+        //Pending items come back in no particular order when they are enqueued again
+        vector<pair<int, int>> pending;
+        original.forEachEntry([&pending](const int& element, int priority) {
+            pending.emplace_back(element, priority);
+        });
+        shuffle(pending.begin(), pending.end(), gen);
+        PriorityQueueMinHeap<int> enqueued;
+        auto start = chrono::high_resolution_clock::now();
+        for (const pair<int, int>& item : pending) {
+            enqueued.enqueue(item.first, item.second);
+        }
+        auto stop = chrono::high_resolution_clock::now();
+        double enqueueTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        original.saveSnapshot(path);
+        PriorityQueueMinHeap<int> loaded;
+        start = chrono::high_resolution_clock::now();
+        loaded.loadSnapshot(path);
+        stop = chrono::high_resolution_clock::now();
+        double loadTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+        remove(path.c_str());
+
+        assert(loaded.getSize() == size && loaded.peekPriority() == original.peekPriority());
+        cout << "Size: " << size << "; Enqueue: " << enqueueTime << " ms; Load snapshot: " << loadTime << " ms\n";
+    }
+}
+
+#if !defined(_WIN32)
+//Startup of a heap living in a memory-mapped file against loading the same heap from a snapshot
+void mappedBenchmark() {
+    int mappedSize[] = {100000, 1000000, 10000000};
+    string heapPath = "queue.heap";
+    string snapshotPath = "queue.snapshot";
+    //A file holding nothing but the header has no room for an element, appending has to grow it from scratch
+    {
+        remove(heapPath.c_str());
+        {
+            MappedArray<int> created(heapPath);
+        }
+        [[maybe_unused]] int truncated = ::truncate(heapPath.c_str(), 16);
+        assert(truncated == 0);
+        MappedArray<int> reopened(heapPath);
+        assert(reopened.capacity() == 0);
+        reopened.insert(0, -1);
+        for (int i = 0; i < 5000; i++) {
+            reopened.pushBack(i);
+        }
+        assert(reopened.size() == 5001 && reopened[0] == -1 && reopened[5000] == 4999);
+    }
+    //Mapped heaps merge straight from the storage of the other heap
+    {
+        string otherPath = heapPath + ".other";
+        remove(heapPath.c_str());
+        remove(otherPath.c_str());
+        {
+            MinHeap<Node<int>, MappedArray<Node<int>>> first(in_place, heapPath);
+            MinHeap<Node<int>, MappedArray<Node<int>>> second(in_place, otherPath);
+            for (int i = 0; i < 1000; i++) {
+                first.insert(Node<int>(i, 2 * i));
+                second.insert(Node<int>(i, 2 * i + 1));
+            }
+            first.merge(second);
+            assert(first.size() == 2000 && second.empty());
+            for (int i = 0; i < 2000; i++) {
+                assert(first.extractMin().priority == i);
+            }
+        }
+        remove(otherPath.c_str());
+    }
+    cout << "Mapped heap startup\n";
+    for (int size : mappedSize) {
+        remove(heapPath.c_str());
+        mt19937 gen(2025);
+        uniform_int_distribution<> dist(1, 1000000);
+        PriorityQueueMinHeap<int> original;
+        {
+            MinHeap<Node<int>, MappedArray<Node<int>>> mapped(in_place, heapPath);
+            for (int i = 0; i < size; i++) {
+                int priority = dist(gen);
+                original.enqueue(i, priority);
+                mapped.insert(Node<int>(i, priority));
+            }
+        }
+        original.saveSnapshot(snapshotPath);
+
+        auto start = chrono::high_resolution_clock::now();
+        MinHeap<Node<int>, MappedArray<Node<int>>> reopened(in_place, heapPath);
+        [[maybe_unused]] int mappedMin = reopened.min().priority;
+        auto stop = chrono::high_resolution_clock::now();
+        double mappedTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+
+        start = chrono::high_resolution_clock::now();
+        PriorityQueueMinHeap<int> loaded;
+        loaded.loadSnapshot(snapshotPath);
+        [[maybe_unused]] int loadedMin = loaded.peekPriority();
+        stop = chrono::high_resolution_clock::now();
+        double snapshotTime = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+        remove(snapshotPath.c_str());
+
+        assert(reopened.size() == size && mappedMin == loadedMin);
+        cout << "Size: " << size << "; Mapped: " << mappedTime << " ms; Snapshot: " << snapshotTime << " ms\n";
+    }
+    remove(heapPath.c_str());
+}
+#endif
+
+//Every thread alternates enqueue and tryDequeue on a shared queue, returns millions of operations per second
+template <typename Queue>
+double mpmcThroughput(Queue& queue, int threadCount, int operations) {
+    atomic<bool> go(false);
+    atomic<int> ready(0);
+    vector<thread> threads;
+    int perThread = operations / threadCount;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&queue, &go, &ready, perThread, t]() {
+            mt19937 gen(2025 + t);
+            uniform_int_distribution<> dist(0, 1000000);
+            ready.fetch_add(1);
+            while (!go.load()) this_thread::yield();
+            int element;
+            for (int i = 0; i < perThread; i++) {
+                if (i % 2 == 0) queue.enqueue(i, dist(gen));
+                else queue.tryDequeue(element);
+            }
+        });
+    }
+    while (ready.load() < threadCount) this_thread::yield();
+    auto start = chrono::high_resolution_clock::now();
+    go.store(true);
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    auto stop = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000000.0;
+    return perThread * threadCount / seconds / 1000000.0;
+}
+
+//Shared heap behind a spinlock, a mutex and flat combining, the heap batching combined requests
+//and the lock-free skip list, with 1 to 64 producing and consuming threads
+void concurrentBenchmark() {
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    constexpr int OPERATIONS = 2000000;
+    constexpr int PREFILL = 100000;
+    cout << "Concurrent heap (million operations per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, SpinLockSync> spinLocked;
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, MutexSync> mutexLocked;
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, FlatCombiningSync> combined;
+        auto* batched = new PriorityQueueFlatCombining<int>();
+        auto* skipList = new PriorityQueueLockFreeSkipList<int>();
+        for (int i = 0; i < PREFILL; i++) {
+            spinLocked.enqueue(i, i);
+            mutexLocked.enqueue(i, i);
+            combined.enqueue(i, i);
+            batched->enqueue(i, i);
+            skipList->enqueue(i, i);
+        }
+        double spinTime = mpmcThroughput(spinLocked, threadCount, OPERATIONS);
+        double mutexTime = mpmcThroughput(mutexLocked, threadCount, OPERATIONS);
+        double combinedTime = mpmcThroughput(combined, threadCount, OPERATIONS);
+        double batchedTime = mpmcThroughput(*batched, threadCount, OPERATIONS);
+        double skipListTime = mpmcThroughput(*skipList, threadCount, OPERATIONS);
+        assert(spinLocked.getSize() == PREFILL && mutexLocked.getSize() == PREFILL && combined.getSize() == PREFILL);
+        assert(batched->getSize() == PREFILL && skipList->getSize() == PREFILL);
+        delete batched;
+        delete skipList;
+        cout << "Threads: " << threadCount << "; Spinlock: " << spinTime << "; Mutex: " << mutexTime
+             << "; Flat combining: " << combinedTime << "; Combining heap: " << batchedTime
+             << "; Lock-free skip list: " << skipListTime << "\n";
+    }
+}
+
+//MultiQueue with two heaps per thread against one locked heap, and its rank error measured in a separate run
+void multiQueueBenchmark() {
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    constexpr int OPERATIONS = 2000000;
+    constexpr int PREFILL = 100000;
+    cout << "MultiQueue (million operations per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, MutexSync> locked;
+        auto* multiQueue = new PriorityQueueMultiQueue<int>(threadCount);
+        for (int i = 0; i < PREFILL; i++) {
+            locked.enqueue(i, i);
+            multiQueue->enqueue(i, i);
+        }
+        double lockedTime = mpmcThroughput(locked, threadCount, OPERATIONS);
+        double multiQueueTime = mpmcThroughput(*multiQueue, threadCount, OPERATIONS);
+        delete multiQueue;
+
+        RankErrorMeter meter(1000000);
+        multiQueue = new PriorityQueueMultiQueue<int>(threadCount);
+        multiQueue->attachRankMeter(&meter);
+        for (int i = 0; i < PREFILL; i++) {
+            multiQueue->enqueue(i, i * 10);
+        }
+        mpmcThroughput(*multiQueue, threadCount, OPERATIONS / 4);
+        delete multiQueue;
+        cout << "Threads: " << threadCount << "; Locked heap: " << lockedTime << "; MultiQueue: " << multiQueueTime
+             << "; Mean rank error: " << meter.meanRank() << "; Max rank error: " << meter.maxRank() << "\n";
+    }
+}
+
+//Sharded queue with one heap per thread against one locked heap and the MultiQueue
+//The queue is filled by the main thread with the smallest priorities, and workers whose head is behind by more
+//than a hundredth of the priority range steal them
+void shardedBenchmark() {
+    int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    constexpr int OPERATIONS = 2000000;
+    constexpr int PREFILL = 100000;
+    cout << "Sharded queue (million operations per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, MutexSync> locked;
+        auto* multiQueue = new PriorityQueueMultiQueue<int>(threadCount);
+        auto* sharded = new ShardedPriorityQueue<int>(threadCount, 10000);
+        for (int i = 0; i < PREFILL; i++) {
+            locked.enqueue(i, i);
+            multiQueue->enqueue(i, i);
+            sharded->enqueue(i, i);
+        }
+        double lockedTime = mpmcThroughput(locked, threadCount, OPERATIONS);
+        double multiQueueTime = mpmcThroughput(*multiQueue, threadCount, OPERATIONS);
+        double shardedTime = mpmcThroughput(*sharded, threadCount, OPERATIONS);
+        assert(sharded->getSize() == PREFILL);
+        cout << "Threads: " << threadCount << "; Locked heap: " << lockedTime << "; MultiQueue: " << multiQueueTime
+             << "; Sharded: " << shardedTime << "; Steals: " << sharded->steals() << "\n";
+        delete multiQueue;
+        delete sharded;
+    }
+}
+
+//Heap with a lock per node against the same heap layout behind one mutex or one spinlock, with 2 to 32 threads
+void fineGrainedBenchmark() {
+    int threadCounts[] = {2, 4, 8, 16, 32};
+    constexpr int OPERATIONS = 2000000;
+    constexpr int PREFILL = 100000;
+    cout << "Fine-grained heap (million operations per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, MutexSync> mutexLocked;
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, SpinLockSync> spinLocked;
+        auto* fineGrained = new PriorityQueueFineGrainedHeap<int>();
+        for (int i = 0; i < PREFILL; i++) {
+            mutexLocked.enqueue(i, i);
+            spinLocked.enqueue(i, i);
+            fineGrained->enqueue(i, i);
+        }
+        double mutexTime = mpmcThroughput(mutexLocked, threadCount, OPERATIONS);
+        double spinTime = mpmcThroughput(spinLocked, threadCount, OPERATIONS);
+        double fineGrainedTime = mpmcThroughput(*fineGrained, threadCount, OPERATIONS);
+        assert(fineGrained->getSize() == PREFILL);
+        delete fineGrained;
+        cout << "Threads: " << threadCount << "; Mutex: " << mutexTime << "; Spinlock: " << spinTime
+             << "; Fine-grained: " << fineGrainedTime << "\n";
+    }
+}
+
+//Producer threads enqueue while the calling thread dequeues everything as the only consumer,
+//returns millions of elements per second passing through the queue
+template <typename Queue>
+double ingestionThroughput(Queue& queue, int producerCount, int elements) {
+    atomic<bool> go(false);
+    atomic<int> ready(0);
+    vector<thread> producers;
+    int perProducer = elements / producerCount;
+    for (int p = 0; p < producerCount; p++) {
+        producers.emplace_back([&queue, &go, &ready, perProducer, p]() {
+            mt19937 gen(2025 + p);
+            uniform_int_distribution<> dist(0, 1000000);
+            ready.fetch_add(1);
+            while (!go.load()) this_thread::yield();
+            for (int i = 0; i < perProducer; i++) {
+                queue.enqueue(i, dist(gen));
+            }
+        });
+    }
+    while (ready.load() < producerCount) this_thread::yield();
+    auto start = chrono::high_resolution_clock::now();
+    go.store(true);
+    int element;
+    for (int received = 0; received < perProducer * producerCount;) {
+        if (queue.tryDequeue(element)) received++;
+        else this_thread::yield();
+    }
+    auto stop = chrono::high_resolution_clock::now();
+    for (thread& producer : producers) {
+        producer.join();
+    }
+    double seconds = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000000.0;
+    return perProducer * producerCount / seconds / 1000000.0;
+}
+
+//Many producers and one consumer: producers share the lock of one heap, or push into their own rings
+//that the consumer drains into its heap in batches
+void ingestionBenchmark() {
+    int producerCounts[] = {1, 2, 4, 8, 16, 32};
+    constexpr int ELEMENTS = 2000000;
+    cout << "Ingestion (million elements per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int producerCount : producerCounts) {
+        ConcurrentPriorityQueue<PriorityQueueMinHeap<int>, MutexSync> locked;
+        auto* rings = new IngestionPriorityQueue<PriorityQueueMinHeap<int>>(producerCount + 1);
+        double lockedTime = ingestionThroughput(locked, producerCount, ELEMENTS);
+        double ringTime = ingestionThroughput(*rings, producerCount, ELEMENTS);
+        assert(locked.isEmpty() && rings->isEmpty());
+        delete rings;
+        cout << "Producers: " << producerCount << "; Locked heap: " << lockedTime << "; Rings: " << ringTime << "\n";
+    }
+}
+
+//One producer enqueues bursts with pauses in between while consumers either poll with tryDequeue or sleep
+//in waitDequeue until the producer closes the queue, prints wall and processor time of both runs
+void blockingBenchmark() {
+    int consumerCounts[] = {1, 2, 4, 8, 16};
+    constexpr int BURSTS = 200;
+    constexpr int BURST_SIZE = 256;
+    cout << "Blocking dequeue (" << thread::hardware_concurrency() << " cores)\n";
+    for (int consumerCount : consumerCounts) {
+        double wall[2];
+        double cpu[2];
+        for (int blocking = 0; blocking < 2; blocking++) {
+            BlockingPriorityQueue<PriorityQueueMinHeap<int>> queue;
+            atomic<int> received(0);
+            vector<thread> consumers;
+            clock_t cpuStart = clock();
+            auto start = chrono::high_resolution_clock::now();
+            for (int c = 0; c < consumerCount; c++) {
+                consumers.emplace_back([&queue, &received, blocking]() {
+                    int element;
+                    if (blocking) {
+                        while (queue.waitDequeue(element)) {
+                            received.fetch_add(1);
+                        }
+                        return;
+                    }
+                    while (received.load() < BURSTS * BURST_SIZE) {
+                        if (queue.tryDequeue(element)) received.fetch_add(1);
+                        else this_thread::yield();
+                    }
+                });
+            }
+            mt19937 gen(2025);
+            uniform_int_distribution<> dist(0, 1000000);
+            vector<SnapshotEntry<int>> burst;
+            for (int b = 0; b < BURSTS; b++) {
+                burst.clear();
+                for (int i = 0; i < BURST_SIZE; i++) {
+                    burst.push_back(SnapshotEntry<int>{dist(gen), i});
+                }
+                queue.enqueueBulk(burst);
+                this_thread::sleep_for(chrono::microseconds(500));
+            }
+            queue.close();
+            for (thread& consumer : consumers) {
+                consumer.join();
+            }
+            assert(received.load() == BURSTS * BURST_SIZE);
+            auto stop = chrono::high_resolution_clock::now();
+            wall[blocking] = chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000.0;
+            cpu[blocking] = 1000.0 * (clock() - cpuStart) / CLOCKS_PER_SEC;
+        }
+        cout << "Consumers: " << consumerCount << "; Polling: " << wall[0] << " ms wall, " << cpu[0]
+             << " ms CPU; Blocking: " << wall[1] << " ms wall, " << cpu[1] << " ms CPU\n";
+    }
+}
+
+//Request that gives way to more urgent requests steps times before it finishes
+PriorityTask requestTask(PriorityExecutor<>& executor, int priority, int steps, atomic<long long>& resumes) {
+    for (int i = 0; i < steps; i++) {
+        co_await executor.schedule(priority);
+        resumes.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+//Consumer taking elements until it gets a negative one
+PriorityTask consumerTask(AsyncPriorityQueue<int>& queue, atomic<int>& received) {
+    while (true) {
+        int element = co_await queue.dequeue();
+        if (element < 0) co_return;
+        received.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+//Coroutines scheduled by priority on the calling thread and on pools of worker threads: many requests yielding
+//to each other, and consumers awaiting elements that the main thread enqueues
+void executorBenchmark() {
+    int threadCounts[] = {0, 1, 2, 4, 8};
+    constexpr int REQUESTS = 10000;
+    constexpr int STEPS = 20;
+    constexpr int ELEMENTS = 500000;
+    constexpr int CONSUMERS = 16;
+    cout << "Priority executor (million resumes per second, " << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        mt19937 gen(2025);
+        uniform_int_distribution<> dist(0, 1000000);
+        atomic<long long> resumes(0);
+        auto start = chrono::high_resolution_clock::now();
+        {
+            PriorityExecutor<> executor(threadCount);
+            for (int r = 0; r < REQUESTS; r++) {
+                int priority = dist(gen);
+                executor.spawn(requestTask(executor, priority, STEPS, resumes), priority);
+            }
+            if (threadCount == 0) executor.run();
+            else executor.waitAll();
+        }
+        auto stop = chrono::high_resolution_clock::now();
+        assert(resumes.load() == static_cast<long long>(REQUESTS) * STEPS);
+        double requestTime = resumes.load() / (chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000000.0) / 1000000.0;
+
+        atomic<int> received(0);
+        start = chrono::high_resolution_clock::now();
+        {
+            PriorityExecutor<> executor(threadCount);
+            AsyncPriorityQueue<int> queue(executor);
+            for (int c = 0; c < CONSUMERS; c++) {
+                executor.spawn(consumerTask(queue, received), 0);
+            }
+            for (int i = 0; i < ELEMENTS; i++) {
+                queue.enqueue(i, dist(gen));
+                if (threadCount == 0 && i % 64 == 63) executor.run();
+            }
+            for (int c = 0; c < CONSUMERS; c++) {
+                queue.enqueue(-1, INT_MAX);
+            }
+            if (threadCount == 0) executor.run();
+            else executor.waitAll();
+        }
+        stop = chrono::high_resolution_clock::now();
+        assert(received.load() == ELEMENTS);
+        double queueTime = ELEMENTS / (chrono::duration_cast<chrono::microseconds>(stop - start).count() / 1000000.0) / 1000000.0;
+        cout << "Threads: " << (threadCount == 0 ? string("caller") : to_string(threadCount)) << "; Requests: " << requestTime
+             << "; Async queue: " << queueTime << "\n";
+    }
+}
+
+//Short task: a few hundred multiplications
+unsigned shortTask(int seed) {
+    unsigned value = static_cast<unsigned>(seed);
+    for (int i = 0; i < 200; i++) {
+        value = value * 2654435761u + 1;
+    }
+    return value;
+}
+
+//Prints throughput and latency percentiles in microseconds from submission to start
+void printPoolRun(const string& name, int tasks, double seconds, vector<long long>& latencies) {
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))] / 1000.0;
+    };
+    cout << name << ": " << tasks / seconds / 1000000.0 << " million tasks/s; p50: " << percentile(0.5)
+         << " us; p99: " << percentile(0.99) << " us; p99.9: " << percentile(0.999) << " us";
+}
+
+//Short tasks with random priorities on the priority thread pool and on workers sharing one mutex-locked heap
+void poolBenchmark() {
+    int threadCounts[] = {1, 2, 4, 8};
+    constexpr int TASKS = 200000;
+    cout << "Priority thread pool (" << thread::hardware_concurrency() << " cores)\n";
+    for (int threadCount : threadCounts) {
+        mt19937 gen(2025);
+        uniform_int_distribution<> dist(0, 1000000);
+        vector<int> priorities(TASKS);
+        for (int& priority : priorities) {
+            priority = dist(gen);
+        }
+        vector<chrono::high_resolution_clock::time_point> submitted(TASKS);
+        vector<long long> latencies(TASKS);
+        atomic<unsigned> sink(0);
+
+        //Workers sharing one locked heap of task indices until it is closed and empty
+        auto start = chrono::high_resolution_clock::now();
+        {
+            BlockingPriorityQueue<PriorityQueueMinHeap<int>> shared;
+            vector<thread> workers;
+            for (int w = 0; w < threadCount; w++) {
+                workers.emplace_back([&]() {
+                    int task;
+                    while (shared.waitDequeue(task)) {
+                        latencies[task] = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - submitted[task]).count();
+                        sink.fetch_add(shortTask(task), memory_order_relaxed);
+                    }
+                });
+            }
+            for (int i = 0; i < TASKS; i++) {
+                submitted[i] = chrono::high_resolution_clock::now();
+                shared.enqueue(i, priorities[i]);
+            }
+            shared.close();
+            for (thread& worker : workers) {
+                worker.join();
+            }
+        }
+        double lockedSeconds = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - start).count() / 1000000.0;
+        cout << "Threads: " << threadCount << "; ";
+        printPoolRun("Locked heap", TASKS, lockedSeconds, latencies);
+
+        start = chrono::high_resolution_clock::now();
+        long long steals;
+        {
+            PriorityThreadPool<> pool(threadCount);
+            vector<TaskHandle<void>> handles;
+            handles.reserve(TASKS);
+            for (int i = 0; i < TASKS; i++) {
+                submitted[i] = chrono::high_resolution_clock::now();
+                handles.push_back(pool.submit([&, i]() {
+                    latencies[i] = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - submitted[i]).count();
+                    sink.fetch_add(shortTask(i), memory_order_relaxed);
+                }, priorities[i]));
+            }
+            for (TaskHandle<void>& handle : handles) {
+                handle.get();
+            }
+            steals = pool.steals();
+        }
+        double poolSeconds = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - start).count() / 1000000.0;
+        cout << "; ";
+        printPoolRun("Pool", TASKS, poolSeconds, latencies);
+        cout << "; Steals: " << steals << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "dijkstra") {
+        dijkstraBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "timers") {
+        timerBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "hold") {
+        holdBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "topk") {
+        topKBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "scaling") {
+        scalingBenchmark(argc > 2 ? stoi(argv[2]) : 100000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "external") {
+        externalBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "snapshot") {
+        snapshotBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "concurrent") {
+        concurrentBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "multiqueue") {
+        multiQueueBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "sharded") {
+        shardedBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "finegrained") {
+        fineGrainedBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "ingestion") {
+        ingestionBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "blocking") {
+        blockingBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "executor") {
+        executorBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "pool") {
+        poolBenchmark();
+        return 0;
+    }
+#if !defined(_WIN32)
+    if (argc > 1 && string(argv[1]) == "mapped") {
+        mappedBenchmark();
+        return 0;
+    }
+#endif
 
     PriorityQueueFibonacciHeap<int> heap1;
     heap1.enqueue(10, 5);
@@ -42,12 +944,28 @@ int main() {
     PriorityQueue<string>* linkedList = new PriorityQueueLinkedList<string>();
     PriorityQueue<string>* heap = new PriorityQueueMinHeap<string>();
     PriorityQueue<string>* fibonacciHeap = new PriorityQueueFibonacciHeap<string>();
+    PriorityQueue<string>* unrolledLinkedList = new PriorityQueueUnrolledLinkedList<string>();
+    PriorityQueue<string>* bucketQueue = new PriorityQueueBucket<string>();
+    PriorityQueue<string>* calendarQueue = new PriorityQueueCalendar<string>();
+    PriorityQueue<string>* pairingHeap = new PriorityQueuePairingHeap<string>();
+    PriorityQueue<string>* binomialHeap = new PriorityQueueBinomialHeap<string>();
+    PriorityQueue<string>* minMaxHeap = new PriorityQueueMinMaxHeap<string>();
+    PriorityQueue<string>* vanEmdeBoas = new PriorityQueueVanEmdeBoas<string>();
+    PriorityQueue<string>* sequenceHeap = new PriorityQueueSequenceHeap<string>();
 
-    int structures[] = {0, 1, 2};
+    int structures[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     map<int, string> structuresMap = {
             {0, "Linked List"},
             {1, "Heap"},
-            {2, "Fibonacci Heap"}
+            {2, "Fibonacci Heap"},
+            {3, "Unrolled Linked List"},
+            {4, "Bucket Queue"},
+            {5, "Calendar Queue"},
+            {6, "Pairing Heap"},
+            {7, "Binomial Heap"},
+            {8, "Min-Max Heap"},
+            {9, "Van Emde Boas Queue"},
+            {10, "Sequence Heap"}
     };
 
     int queueSize[] = {100, 500, 1000, 5000, 10000, 50000, 100000};
@@ -62,6 +980,30 @@ int main() {
             case 2:
                 pq = fibonacciHeap;
                 break;
+            case 3:
+                pq = unrolledLinkedList;
+                break;
+            case 4:
+                pq = bucketQueue;
+                break;
+            case 5:
+                pq = calendarQueue;
+                break;
+            case 6:
+                pq = pairingHeap;
+                break;
+            case 7:
+                pq = binomialHeap;
+                break;
+            case 8:
+                pq = minMaxHeap;
+                break;
+            case 9:
+                pq = vanEmdeBoas;
+                break;
+            case 10:
+                pq = sequenceHeap;
+                break;
 
         }
         cout << structuresMap[structure] << "\n";
@@ -139,4 +1081,12 @@ int main() {
     delete linkedList;
     delete heap;
     delete fibonacciHeap;
+    delete unrolledLinkedList;
+    delete bucketQueue;
+    delete calendarQueue;
+    delete pairingHeap;
+    delete binomialHeap;
+    delete minMaxHeap;
+    delete vanEmdeBoas;
+    delete sequenceHeap;
 }
\ No newline at end of file